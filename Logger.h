@@ -3,12 +3,24 @@
 
 /*********************** EXTERNAL LIBRARIES **********************/
 
-#include <Arduino.h>
-#include <esp_log.h>
+#ifdef ARDUINO
+  #include <Arduino.h>
+  #include <esp_log.h>
+#else     // ESP-IDF component or host build, the Arduino log macros are mapped to esp_log
+  #include "TouchPlatform.h"
+  #ifndef LOGGER_TAG
+    #define LOGGER_TAG    "TouchSlider"
+  #endif
+  #define log_e(format, ...)          ESP_LOGE(LOGGER_TAG, format, ##__VA_ARGS__)
+  #define log_w(format, ...)          ESP_LOGW(LOGGER_TAG, format, ##__VA_ARGS__)
+  #define log_i(format, ...)          ESP_LOGI(LOGGER_TAG, format, ##__VA_ARGS__)
+  #define log_d(format, ...)          ESP_LOGD(LOGGER_TAG, format, ##__VA_ARGS__)
+  #define log_v(format, ...)          ESP_LOGV(LOGGER_TAG, format, ##__VA_ARGS__)
+#endif
 #include <stdarg.h>
 #include <stdio.h>
 
-#ifdef CONFIG_LOGGER_COLORS    // Controlled by -D CONFIG_LOGGER_COLORS in platformio.ini
+#if defined(CONFIG_LOGGER_COLORS) || defined(CONFIG_TOUCHSLIDER_LOGGER_COLORS)    // -D CONFIG_LOGGER_COLORS in platformio.ini, or menuconfig on ESP-IDF
   #define LOGGER_COLOR_RED     "\e[31m" 
   #define LOGGER_COLOR_GREEN   "\e[32m" 
   #define LOGGER_COLOR_YELLOW  "\e[33m" 
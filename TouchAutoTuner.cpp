@@ -0,0 +1,158 @@
+#include "TouchAutoTuner.h"
+
+/*********************** CONSTRUCTORS **********************/
+/**
+ * @brief Constructor for TouchAutoTuner class
+ *
+ * @param voltages Array of voltage range indexes to sweep.
+ * @param numVoltages Number of voltage ranges, limited to TUNE_MAX_VOLTAGES.
+ * @param measCycles Array of measurement cycles to sweep, sorted here from the shortest.
+ * @param numMeasCycles Number of measurement cycles, limited to TUNE_MAX_MEAS_CYCLES.
+ **/
+TouchAutoTuner::TouchAutoTuner(const uint8_t voltages[], uint8_t numVoltages, const uint16_t measCycles[], uint8_t numMeasCycles) {
+  _numVoltages = numVoltages < TUNE_MAX_VOLTAGES ? numVoltages : TUNE_MAX_VOLTAGES;
+  for (uint8_t i = 0; i < _numVoltages; ++i) {
+    _voltages[i] = voltages[i];
+  }
+
+  _numMeasCycles = numMeasCycles < TUNE_MAX_MEAS_CYCLES ? numMeasCycles : TUNE_MAX_MEAS_CYCLES;
+  for (uint8_t i = 0; i < _numMeasCycles; ++i) {   // Insert each measurement sorted, the search needs them from shortest
+    uint8_t j = i;
+    while (j > 0 && _measCycles[j - 1] > measCycles[i]) {
+      _measCycles[j] = _measCycles[j - 1];
+      --j;
+    }
+    _measCycles[j] = measCycles[i];
+  }
+
+  for (uint8_t i = 0; i < TUNE_MAX_PADS; ++i) {
+    _bestPadSnr[i] = 0;
+  }
+}
+
+/*********************** PUBLIC FUNCTIONS **********************/
+/**
+ * @brief Set the readings taken per pad and setting.
+ * @param samples Number of readings, between 2 and TUNE_MAX_SAMPLES.
+ */
+void TouchAutoTuner::setSamples(uint8_t samples) {
+  if (samples < 2) samples = 2;
+  if (samples > TUNE_MAX_SAMPLES) samples = TUNE_MAX_SAMPLES;
+  _samples = samples;
+}
+
+/**
+ * @brief Find the shortest measurement that meets the target SNR on every pad.
+ *
+ * For each voltage range a binary search looks for the shortest measurement cycles meeting the target, only between the
+ * shortest cycles and the best ones found so far. With the same cycles the setting with the higher SNR is kept.
+ * If no setting meets the target, the profile with the highest SNR measured is returned as not valid.
+ *
+ * @param sensor The sensor to measure.
+ * @return The profile found.
+ */
+TouchTuneProfile TouchAutoTuner::tune(TouchTuneSensor &sensor) {
+  TouchTuneProfile best = {false, 0, 0, 0};
+  int8_t bestIndex = _numMeasCycles;                // Index of the measurement cycles of the best valid profile
+  _measuredSettings = 0;
+
+  for (uint8_t v = 0; v < _numVoltages; ++v) {
+    int8_t low = 0;
+    int8_t high = bestIndex < _numMeasCycles ? bestIndex : _numMeasCycles - 1;
+    int8_t found = -1;
+    uint16_t foundSnr = 0;
+    uint16_t foundPadSnr[TUNE_MAX_PADS];
+
+    while (low <= high) {   // Shortest measurement meeting the target, the SNR grows with the cycles
+      int8_t middle = (low + high) / 2;
+      TouchTuneSetting setting = {_voltages[v], _measCycles[middle]};
+      uint16_t snr = measure(sensor, setting);
+
+      if (!best.valid && snr > best.snr) {    // Keep the best effort while nothing meets the target
+        best = {false, setting.voltage, setting.measCycles, snr};
+        for (uint8_t i = 0; i < TUNE_MAX_PADS; ++i) _bestPadSnr[i] = _padSnr[i];
+      }
+
+      if (snr >= _targetSnr) {
+        found = middle;
+        foundSnr = snr;
+        for (uint8_t i = 0; i < TUNE_MAX_PADS; ++i) foundPadSnr[i] = _padSnr[i];
+        high = middle - 1;
+      } else {
+        low = middle + 1;
+      }
+    }
+
+    if (found >= 0 && (found < bestIndex || !best.valid || foundSnr > best.snr)) {
+      bestIndex = found;
+      best = {true, _voltages[v], _measCycles[found], foundSnr};
+      for (uint8_t i = 0; i < TUNE_MAX_PADS; ++i) _bestPadSnr[i] = foundPadSnr[i];
+    }
+  }
+  return best;
+}
+
+/**
+ * @brief Measure the SNR of every pad with a setting.
+ *
+ * The noise is the standard deviation of the readings, the signal is the threshold delta of the pad from the mean reading.
+ * It is a proxy of the SNR of a touch, no touch is measured.
+ *
+ * @param sensor The sensor to measure.
+ * @param setting The setting to apply.
+ * @return The lowest SNR of the pads (Q4).
+ */
+uint16_t TouchAutoTuner::measure(TouchTuneSensor &sensor, const TouchTuneSetting &setting) {
+  uint8_t numPads = sensor.getNumPads();
+  if (numPads > TUNE_MAX_PADS) numPads = TUNE_MAX_PADS;
+
+  uint64_t sum[TUNE_MAX_PADS] = {};
+  uint64_t sumSquares[TUNE_MAX_PADS] = {};
+
+  sensor.apply(setting);
+  _measuredSettings++;
+  for (uint8_t sample = 0; sample < _samples; ++sample) {   // Interleave the pads, all of them see the same conditions
+    for (uint8_t pad = 0; pad < numPads; ++pad) {
+      uint32_t reading = sensor.read(pad);
+      sum[pad] += reading;
+      sumSquares[pad] += static_cast<uint64_t>(reading) * reading;
+    }
+  }
+
+  uint16_t lowestSnr = UINT16_MAX;
+  for (uint8_t pad = 0; pad < numPads; ++pad) {
+    uint64_t mean = sum[pad] / _samples;
+    uint64_t meanSquares = sumSquares[pad] / _samples;
+    uint64_t variance = meanSquares > mean * mean ? meanSquares - mean * mean : 0;
+    uint32_t noise = isqrt(variance);
+    uint64_t signal = mean - mean * sensor.getThresholdPercent(pad) / 100;
+
+    uint64_t snr = noise == 0 ? UINT16_MAX : (signal * TUNE_SNR_ONE) / noise;
+    _padSnr[pad] = snr > UINT16_MAX ? UINT16_MAX : snr;
+    if (_padSnr[pad] < lowestSnr)
+      lowestSnr = _padSnr[pad];
+  }
+  return numPads > 0 ? lowestSnr : 0;
+}
+
+/**
+ * @brief Integer square root.
+ * @param value The value.
+ * @return The largest integer whose square is not greater than the value.
+ */
+uint32_t TouchAutoTuner::isqrt(uint64_t value) {
+  uint64_t result = 0;
+  uint64_t bit = 1ULL << 62;
+  while (bit > value) bit >>= 2;
+
+  while (bit != 0) {
+    if (value >= result + bit) {
+      value -= result + bit;
+      result = (result >> 1) + bit;
+    } else {
+      result >>= 1;
+    }
+    bit >>= 2;
+  }
+  return static_cast<uint32_t>(result);
+}
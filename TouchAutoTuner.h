@@ -0,0 +1,94 @@
+/*
+* Marcos Abraham Carballo Vazquez
+* Original Creation Date: Dicember 5, 2024
+* https://github.com/MarcosCarballoV/TouchSlider_ESP32
+* */
+
+#ifndef TOUCHAUTOTUNER_H
+#define TOUCHAUTOTUNER_H
+
+/**
+* Auto-tuner of the touch measurement: reference voltage range and measurement (charge/discharge) cycles.
+*
+* For each setting the tuner takes some raw readings of every pad, untouched, and computes the SNR of each pad as the
+* threshold delta (mean * (100 - thresholdPercent) / 100) divided by the standard deviation of the readings. The
+* SNR grows with the measurement cycles, so for each voltage range a binary search finds the shortest measurement that
+* meets the target SNR on every pad. The shortest measurement of all the voltage ranges is kept as the profile.
+*
+* This SNR is a proxy: no finger is measured, the signal is the fraction of the mean reading that the threshold asks a
+* touch to change. It tells how far the noise stays from the threshold, a weak touch (thick overlay, gloves) can still
+* fall short of it.
+*
+* The readings come from a TouchTuneSensor: TouchSlider::autoTune() uses the touch peripheral, and on a host any model
+* of the electrodes can implement it to check the search logic (see tests/TouchTuneModel.h).
+*/
+/*********************** EXTERNAL LIBRARIES **********************/
+
+#include <stdint.h>
+
+/*********************** LIBRARY OPTIONS **********************/
+#define TUNE_MAX_PADS             15          // Maximum number of pads tuned at once
+#define TUNE_MAX_VOLTAGES         8           // Maximum number of voltage ranges swept
+#define TUNE_MAX_MEAS_CYCLES      12          // Maximum number of measurement cycles swept
+#define TUNE_MAX_SAMPLES          128         // Maximum number of readings per pad and setting
+#define TUNE_SNR_ONE              16          // SNR of 1 (SNR values are fixed-point Q4)
+
+/*********************** TYPES **********************/
+struct TouchTuneSetting {
+  uint8_t voltage;                // Index of the voltage range (see TouchDriver::setVoltage)
+  uint16_t measCycles;            // Measurement cycles (see TouchDriver::setMeasurementCycles)
+};
+
+struct TouchTuneProfile {
+  bool valid;                     // Indicates whether the profile meets the target SNR
+  uint8_t voltage;                // Index of the voltage range
+  uint16_t measCycles;            // Measurement cycles
+  uint16_t snr;                   // Lowest SNR of the pads with this setting (Q4)
+};
+
+/*********************** CLASS DEFINITION **********************/
+
+class TouchTuneSensor
+{
+  public:
+    virtual ~TouchTuneSensor() {}
+    virtual void apply(const TouchTuneSetting &setting) = 0;          // Apply a setting and wait until the readings are stable
+    virtual uint32_t read(uint8_t pad) = 0;                           // Take a raw reading of a pad (0 to getNumPads() - 1)
+    virtual uint8_t getNumPads() = 0;                                 // Get the number of pads
+    virtual uint8_t getThresholdPercent(uint8_t pad) = 0;             // Get the threshold percentage of a pad
+};
+
+class TouchAutoTuner
+{
+  public:
+    // Constructor
+    TouchAutoTuner(const uint8_t voltages[], uint8_t numVoltages, const uint16_t measCycles[], uint8_t numMeasCycles);   // Constructor with the settings to sweep
+
+    // Configuration
+    void setTargetSnr(uint16_t targetSnr) {_targetSnr = targetSnr;};              // Set the target SNR (Q4)
+    void setSamples(uint8_t samples);                                             // Set the readings per pad and setting
+
+    // Tuning
+    TouchTuneProfile tune(TouchTuneSensor &sensor);                               // Find the shortest measurement that meets the target SNR
+    uint16_t measure(TouchTuneSensor &sensor, const TouchTuneSetting &setting);   // Measure the SNR of every pad with a setting, returns the lowest one
+
+    // Getters
+    uint16_t getPadSnr(uint8_t pad) {return pad < TUNE_MAX_PADS ? _bestPadSnr[pad] : 0;};   // Get the SNR of a pad with the setting of the profile (Q4)
+    uint8_t getMeasuredSettings() {return _measuredSettings;};                    // Get the number of settings measured by the last tune
+
+    // Helpers
+    static uint32_t isqrt(uint64_t value);                                        // Integer square root
+
+  private:
+    uint8_t _voltages[TUNE_MAX_VOLTAGES];                             // Voltage ranges to sweep
+    uint8_t _numVoltages = 0;                                         // Number of voltage ranges
+    uint16_t _measCycles[TUNE_MAX_MEAS_CYCLES];                       // Measurement cycles to sweep, sorted from shortest
+    uint8_t _numMeasCycles = 0;                                       // Number of measurement cycles
+    uint16_t _targetSnr = 5 * TUNE_SNR_ONE;                           // Target SNR (Q4)
+    uint8_t _samples = 32;                                            // Readings per pad and setting
+
+    uint16_t _padSnr[TUNE_MAX_PADS];                                  // SNR of each pad with the last setting measured
+    uint16_t _bestPadSnr[TUNE_MAX_PADS];                              // SNR of each pad with the setting of the profile
+    uint8_t _measuredSettings = 0;                                    // Settings measured by the last tune
+};
+#endif
@@ -0,0 +1,399 @@
+#include "TouchDriver.h"
+
+#if defined(TOUCHSLIDER_HOST_DRIVER)
+/*********************** VARIABLES **********************/
+// Static members of the driver stand-in must be initialized here
+uint32_t TouchDriverHost::_filtered[TOUCH_PAD_MAX];         // Array to store the filtered value reported for each touch pad
+uint32_t TouchDriverHost::_baseline[TOUCH_PAD_MAX];         // Array to store the benchmark reported for each touch pad
+uint32_t TouchDriverHost::_threshold[TOUCH_PAD_MAX];        // Array to store the threshold programmed on each touch pad
+bool TouchDriverHost::_configured[TOUCH_PAD_MAX];           // Array to store the configured status of each touch pad
+bool TouchDriverHost::_running = false;                     // Measurement status
+uint8_t TouchDriverHost::_voltage = 0;                      // Voltage range set
+uint16_t TouchDriverHost::_measCycles = TOUCH_PAD_MEASURE_CYCLE_DEFAULT;   // Measurement cycles set
+#else
+/*********************** VARIABLES **********************/
+// Reference voltage ranges, from the shortest swing (default, more charge cycles per measurement) to the longest
+static const struct {
+  touch_high_volt_t high;
+  touch_low_volt_t low;
+  touch_volt_atten_t atten;
+} VOLTAGES[] = {
+  {TOUCH_HVOLT_2V7, TOUCH_LVOLT_0V5, TOUCH_HVOLT_ATTEN_1V5},
+  {TOUCH_HVOLT_2V7, TOUCH_LVOLT_0V5, TOUCH_HVOLT_ATTEN_1V},
+  {TOUCH_HVOLT_2V7, TOUCH_LVOLT_0V5, TOUCH_HVOLT_ATTEN_0V5},
+  {TOUCH_HVOLT_2V7, TOUCH_LVOLT_0V5, TOUCH_HVOLT_ATTEN_0V}
+};
+#endif
+
+static const uint8_t NUM_VOLTAGES = 4;                      // Voltage ranges available to setVoltage
+
+#if defined(TOUCHSLIDER_TOUCH_V2)
+static const uint16_t TUNE_CYCLES[] = {50, 100, 200, 300, 500, 1000, 2000};                    // Charge/discharge times
+#else
+static const uint16_t TUNE_CYCLES[] = {0x0400, 0x0800, 0x1000, 0x2000, 0x4000, 0x7FFF};       // 8 MHz cycles, 0.128 ms to 4 ms
+#endif
+
+/*********************** PERIPHERAL CONTROL **********************/
+/**
+ * @brief Initialize the touch peripheral.
+ *
+ * On ESP32 (v1) the FSM is started by timer and the reference voltages are set for charging/discharging.
+ * On ESP32-S2/S3 (v2) the hardware denoise channel and the hardware filter are configured too, so baseline tracking,
+ * noise subtraction and smoothing run on the peripheral instead of on the CPU.
+ */
+void TouchDriver::init() {
+#if defined(TOUCHSLIDER_HOST_DRIVER)
+  for (uint8_t i = 0; i < TOUCH_PAD_MAX; ++i) {
+    TouchDriverHost::_configured[i] = false;
+    TouchDriverHost::_threshold[i] = 0;
+  }
+  TouchDriverHost::_running = false;
+  TouchDriverHost::_voltage = 0;
+  TouchDriverHost::_measCycles = TOUCH_PAD_MEASURE_CYCLE_DEFAULT;
+#elif defined(TOUCHSLIDER_TOUCH_V2)
+  touch_pad_init();                                 // Initialize touch pad peripheral
+  setVoltage(0);
+
+  touch_pad_denoise_t denoise;                      // The denoise channel (TOUCH_PAD_NUM0) is subtracted from every channel in hardware
+  denoise.grade = TOUCH_PAD_DENOISE_BIT4;
+  denoise.cap_level = TOUCH_PAD_DENOISE_CAP_L4;
+  touch_pad_denoise_set_config(&denoise);
+  touch_pad_denoise_enable();
+
+  touch_filter_config_t filterInfo;                 // Hardware filter for the benchmark (baseline) and for the smooth value
+  filterInfo.mode = TOUCH_PAD_FILTER_IIR_16;
+  filterInfo.debounce_cnt = 1;
+  filterInfo.noise_thr = 0;
+  filterInfo.jitter_step = 4;
+  filterInfo.smh_lvl = TOUCH_PAD_SMOOTH_IIR_2;
+  touch_pad_filter_set_config(&filterInfo);
+
+  touch_pad_set_fsm_mode(TOUCH_FSM_MODE_TIMER);
+#else
+  touch_pad_init();                                 // Initialize touch pad peripheral
+  touch_pad_set_fsm_mode(TOUCH_FSM_MODE_TIMER);     // If use interrupt trigger mode, should set TOUCH_FSM_MODE_TIMER
+                                                    // Set reference voltage for charging/discharging
+                                                    // For most usage scenarios, we recommend using the following combination:
+                                                    // the high reference valtage will be 2.7V - 1V = 1.7V, The low reference voltage will be 0.5V.
+  setVoltage(0);
+#endif
+}
+
+/**
+ * @brief Enable the measurement of a touch pad.
+ * @param pad The touch pad to configure.
+ */
+void TouchDriver::configPad(touch_pad_t pad) {
+#if defined(TOUCHSLIDER_HOST_DRIVER)
+  TouchDriverHost::_configured[pad] = true;
+#elif defined(TOUCHSLIDER_TOUCH_V2)
+  touch_pad_config(pad);
+#else
+  touch_pad_config(pad, 0);                         // The interrupt threshold is not used, thresholds are checked by the library
+#endif
+}
+
+/**
+ * @brief Start filtering and measuring the configured touch pads.
+ *
+ * @param filterPeriod Period of the software filter in ms (v1 only, the v2 filter runs in hardware).
+ * @param readCallback Filter output reading hook (v1 only), see ESP-IDF file touch_pad.h for more information.
+ */
+void TouchDriver::start(uint8_t filterPeriod, ReadCallback readCallback) {
+#if defined(TOUCHSLIDER_HOST_DRIVER)
+  (void)filterPeriod;
+  (void)readCallback;
+  TouchDriverHost::_running = true;
+#elif defined(TOUCHSLIDER_TOUCH_V2)
+  (void)filterPeriod;
+  (void)readCallback;
+  touch_pad_filter_enable();
+  touch_pad_fsm_start();
+#else
+  touch_pad_filter_start(filterPeriod);             // Initialize and start a software filter to detect slight change of capacitance.
+  if (readCallback != nullptr)
+    touch_pad_set_filter_read_cb(readCallback);
+#endif
+}
+
+/**
+ * @brief Stop filtering and measuring the touch pads.
+ */
+void TouchDriver::stop() {
+#if defined(TOUCHSLIDER_HOST_DRIVER)
+  TouchDriverHost::_running = false;
+#elif defined(TOUCHSLIDER_TOUCH_V2)
+  touch_pad_fsm_stop();
+  touch_pad_filter_disable();
+#else
+  touch_pad_filter_stop();
+#endif
+}
+
+/*********************** MEASUREMENT SETTINGS **********************/
+/**
+ * @brief Set the reference voltage range used to charge and discharge the touch pads.
+ *
+ * A longer swing needs more time per charge cycle, so it lowers the counts of a measurement but also the noise.
+ *
+ * @param voltage Index of the voltage range (0 to getNumVoltages() - 1), 0 is the default of the library.
+ */
+void TouchDriver::setVoltage(uint8_t voltage) {
+  if (voltage >= NUM_VOLTAGES)
+    return;
+#if defined(TOUCHSLIDER_HOST_DRIVER)
+  TouchDriverHost::_voltage = voltage;
+#else
+  touch_pad_set_voltage(VOLTAGES[voltage].high, VOLTAGES[voltage].low, VOLTAGES[voltage].atten);
+#endif
+}
+
+/**
+ * @brief Set the duration of a measurement.
+ *
+ * On v1 it is the measurement time in 8 MHz cycles, the sleep time between measurements keeps the driver default.
+ * On v2 it is the number of charge/discharge times of a measurement.
+ *
+ * @param measCycles Measurement cycles.
+ */
+void TouchDriver::setMeasurementCycles(uint16_t measCycles) {
+#if defined(TOUCHSLIDER_HOST_DRIVER)
+  TouchDriverHost::_measCycles = measCycles;
+#elif defined(TOUCHSLIDER_TOUCH_V2)
+  touch_pad_set_charge_discharge_times(measCycles);
+#else
+  touch_pad_set_meas_time(TOUCH_PAD_SLEEP_CYCLE_DEFAULT, measCycles);
+#endif
+}
+
+/**
+ * @brief Get the number of reference voltage ranges.
+ * @return The number of voltage ranges accepted by setVoltage().
+ */
+uint8_t TouchDriver::getNumVoltages() {
+  return NUM_VOLTAGES;
+}
+
+/**
+ * @brief Get the measurement cycles set by the driver at initialization.
+ * @return The default measurement cycles.
+ */
+uint16_t TouchDriver::getDefaultMeasurementCycles() {
+  return TOUCH_PAD_MEASURE_CYCLE_DEFAULT;
+}
+
+/**
+ * @brief Get the measurement cycles swept by the auto-tuner, from the shortest.
+ * @param numCycles Number of measurement cycles returned.
+ * @return The measurement cycles.
+ */
+const uint16_t* TouchDriver::getTuneMeasurementCycles(uint8_t &numCycles) {
+  numCycles = sizeof(TUNE_CYCLES) / sizeof(TUNE_CYCLES[0]);
+  return TUNE_CYCLES;
+}
+
+/*********************** READINGS **********************/
+/**
+ * @brief Read the last raw measurement of a touch pad, without any filtering.
+ * @param pad The touch pad to read.
+ * @return The raw value.
+ */
+uint32_t TouchDriver::readRaw(touch_pad_t pad) {
+#if defined(TOUCHSLIDER_HOST_DRIVER)
+  return TouchDriverHost::_filtered[pad];
+#elif defined(TOUCHSLIDER_TOUCH_V2)
+  uint32_t raw = 0;
+  touch_pad_read_raw_data(pad, &raw);
+  return raw;
+#else
+  uint16_t raw = 0;
+  touch_pad_read_raw_data(pad, &raw);
+  return raw;
+#endif
+}
+
+/**
+ * @brief Read the filtered value of a touch pad.
+ * @param pad The touch pad to read.
+ * @return The filtered value (v1: software IIR filter, v2: hardware smooth value).
+ */
+uint32_t TouchDriver::readFiltered(touch_pad_t pad) {
+#if defined(TOUCHSLIDER_HOST_DRIVER)
+  return TouchDriverHost::_filtered[pad];
+#elif defined(TOUCHSLIDER_TOUCH_V2)
+  uint32_t smooth = 0;
+  touch_pad_filter_read_smooth(pad, &smooth);
+  return smooth;
+#else
+  uint16_t filtered = 0;
+  touch_pad_read_filtered(pad, &filtered);
+  return filtered;
+#endif
+}
+
+/**
+ * @brief Read the baseline (untouched value) of a touch pad.
+ *
+ * On v1 there is no baseline tracking, the filtered value is returned and it is only valid while the pad is not touched.
+ * On v2 the benchmark kept by the hardware is returned.
+ *
+ * @param pad The touch pad to read.
+ * @return The baseline of the touch pad.
+ */
+uint32_t TouchDriver::readBaseline(touch_pad_t pad) {
+#if defined(TOUCHSLIDER_HOST_DRIVER) && defined(TOUCHSLIDER_TOUCH_V2)
+  return TouchDriverHost::_baseline[pad];
+#elif defined(TOUCHSLIDER_TOUCH_V2)
+  uint32_t benchmark = 0;
+  touch_pad_read_benchmark(pad, &benchmark);
+  return benchmark;
+#else
+  return readFiltered(pad);
+#endif
+}
+
+/**
+ * @brief Wait until the first measurement of a touch pad gives a baseline.
+ *
+ * Right after start() the filter (v1) or the benchmark (v2) of a pad reads 0 until its first measurement is done, and
+ * a threshold calculated from it would report the pad as touched.
+ *
+ * @param pad The touch pad to wait for.
+ * @param timeoutMs Longest time to wait in ms.
+ * @retval true: The baseline is valid, false: it is still 0 after timeoutMs
+ */
+bool TouchDriver::waitBaseline(touch_pad_t pad, uint32_t timeoutMs) {
+  for (uint32_t waitedMs = 0; readBaseline(pad) == 0; waitedMs += TOUCH_BASELINE_POLL_MS) {
+    if (waitedMs >= timeoutMs)
+      return false;
+    TouchPlatform::delayMs(TOUCH_BASELINE_POLL_MS);
+  }
+  return true;
+}
+
+/**
+ * @brief Program the per-channel threshold of a touch pad.
+ *
+ * Only the v2 peripheral uses it (active status, wake up from sleep). On v1 the thresholds are checked by the library.
+ *
+ * @param pad The touch pad to configure.
+ * @param thresholdDelta Change from the baseline needed to consider the pad touched.
+ */
+void TouchDriver::setPadThreshold(touch_pad_t pad, uint32_t thresholdDelta) {
+#if defined(TOUCHSLIDER_HOST_DRIVER)
+  TouchDriverHost::_threshold[pad] = thresholdDelta;
+#elif defined(TOUCHSLIDER_TOUCH_V2)
+  touch_pad_set_thresh(pad, thresholdDelta);
+#else
+  (void)pad;
+  (void)thresholdDelta;
+#endif
+}
+
+/*********************** BACKEND LOGIC **********************/
+/**
+ * @brief Calculate the threshold of a touch pad from its baseline.
+ *
+ * The threshold is expressed as the change from the baseline needed to consider the pad touched, so the same
+ * percentage works on both backends: on v1 the value drops when touched, on v2 the value rises.
+ *
+ * @param baseline The untouched value of the pad.
+ * @param thresholdPercent (0-100) Higher percentage means more sensitive.
+ * @return The threshold as a change from the baseline.
+ */
+uint32_t TouchDriver::thresholdFromBaseline(uint32_t baseline, uint8_t thresholdPercent) {
+  if (thresholdPercent > 100)
+    thresholdPercent = 100;
+  return baseline - static_cast<uint64_t>(baseline) * thresholdPercent / 100;
+}
+
+/**
+ * @brief Get the signal of a touch pad in the touch direction.
+ * @param filteredValue The filtered value of the pad.
+ * @param baseline The untouched value of the pad.
+ * @return The change from the baseline towards touch, 0 if the value moved the other way.
+ */
+uint32_t TouchDriver::touchDelta(uint32_t filteredValue, uint32_t baseline) {
+#if defined(TOUCHSLIDER_TOUCH_V2)
+  return filteredValue > baseline ? filteredValue - baseline : 0;
+#else
+  return filteredValue < baseline ? baseline - filteredValue : 0;
+#endif
+}
+
+/**
+ * @brief Get the signed change of a touch pad from its baseline.
+ * @param filteredValue The filtered value of the pad.
+ * @param baseline The untouched value of the pad.
+ * @return The change from the baseline, positive towards touch and negative away from it.
+ */
+int32_t TouchDriver::touchChange(uint32_t filteredValue, uint32_t baseline) {
+#if defined(TOUCHSLIDER_TOUCH_V2)
+  return static_cast<int32_t>(filteredValue - baseline);
+#else
+  return static_cast<int32_t>(baseline - filteredValue);
+#endif
+}
+
+/**
+ * @brief Check if a touch pad is touched.
+ * @param filteredValue The filtered value of the pad.
+ * @param baseline The untouched value of the pad.
+ * @param thresholdDelta The threshold as a change from the baseline.
+ * @retval true: The pad is touched
+ */
+bool TouchDriver::isTouched(uint32_t filteredValue, uint32_t baseline, uint32_t thresholdDelta) {
+  return touchDelta(filteredValue, baseline) > thresholdDelta;
+}
+
+/**
+ * @brief Check if the backend keeps the baseline updated.
+ * @retval true: The baseline is tracked by the hardware (v2), false: it is only read at calibration (v1)
+ */
+bool TouchDriver::tracksBaseline() {
+#if defined(TOUCHSLIDER_TOUCH_V2)
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief Map a GPIO pin to its corresponding touch pad.
+ *
+ * This function maps a GPIO pin to its corresponding touch pad number based on the touch sensor of the microcontroller used.
+ * On ESP32-S2/S3 TOUCH_PAD_NUM0 is the internal denoise channel, so it is never mapped.
+ *
+ * @param gpioPin The GPIO pin number to be mapped.
+ * @return The corresponding touch pad number or TOUCH_PAD_MAX if not found.
+ */
+touch_pad_t TouchDriver::mapGpioToTouchPad(gpio_num_t gpioPin) {
+#if !defined(TOUCHSLIDER_TOUCH_V2)
+    if (gpioPin == GPIO_NUM_4) return TOUCH_PAD_NUM0;
+    else if (gpioPin == GPIO_NUM_0) return TOUCH_PAD_NUM1;
+    else if (gpioPin == GPIO_NUM_2) return TOUCH_PAD_NUM2;
+    else if (gpioPin == GPIO_NUM_15) return TOUCH_PAD_NUM3;
+    else if (gpioPin == GPIO_NUM_13) return TOUCH_PAD_NUM4;
+    else if (gpioPin == GPIO_NUM_12) return TOUCH_PAD_NUM5;
+    else if (gpioPin == GPIO_NUM_14) return TOUCH_PAD_NUM6;
+    else if (gpioPin == GPIO_NUM_27) return TOUCH_PAD_NUM7;
+    else if (gpioPin == GPIO_NUM_33) return TOUCH_PAD_NUM8;
+    else if (gpioPin == GPIO_NUM_32) return TOUCH_PAD_NUM9;
+#else
+    if (gpioPin == GPIO_NUM_1) return TOUCH_PAD_NUM1;
+    else if (gpioPin == GPIO_NUM_2) return TOUCH_PAD_NUM2;
+    else if (gpioPin == GPIO_NUM_3) return TOUCH_PAD_NUM3;
+    else if (gpioPin == GPIO_NUM_4) return TOUCH_PAD_NUM4;
+    else if (gpioPin == GPIO_NUM_5) return TOUCH_PAD_NUM5;
+    else if (gpioPin == GPIO_NUM_6) return TOUCH_PAD_NUM6;
+    else if (gpioPin == GPIO_NUM_7) return TOUCH_PAD_NUM7;
+    else if (gpioPin == GPIO_NUM_8) return TOUCH_PAD_NUM8;
+    else if (gpioPin == GPIO_NUM_9) return TOUCH_PAD_NUM9;
+    else if (gpioPin == GPIO_NUM_10) return TOUCH_PAD_NUM10;
+    else if (gpioPin == GPIO_NUM_11) return TOUCH_PAD_NUM11;
+    else if (gpioPin == GPIO_NUM_12) return TOUCH_PAD_NUM12;
+    else if (gpioPin == GPIO_NUM_13) return TOUCH_PAD_NUM13;
+    else if (gpioPin == GPIO_NUM_14) return TOUCH_PAD_NUM14;
+#endif
+    return TOUCH_PAD_MAX;
+}
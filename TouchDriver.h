@@ -0,0 +1,76 @@
+/*
+* Marcos Abraham Carballo Vazquez
+* Original Creation Date: Dicember 5, 2024
+* https://github.com/MarcosCarballoV/TouchSlider_ESP32
+* */
+
+#ifndef TOUCHDRIVER_H
+#define TOUCHDRIVER_H
+
+/**
+* Thin layer over the ESP-IDF touch sensor driver. TouchSlider only talks to the peripheral through this class,
+* so the same public API runs on the original ESP32 touch sensor (v1) and on the ESP32-S2/S3 touch sensor (v2).
+*
+* ESP32 (v1):     software IIR filter (touch_pad_filter_start) and a fixed baseline read once at calibration.
+* ESP32-S2/S3 (v2): hardware smoothing, hardware baseline tracking (benchmark), denoise channel subtraction
+*                   and per-channel thresholds, so the CPU only reads the already processed values.
+*
+* Additional information can be found here:
+* https://docs.espressif.com/projects/esp-idf/en/latest/esp32s3/api-reference/peripherals/touch_pad.html
+*/
+/*********************** EXTERNAL LIBRARIES **********************/
+
+#include <stdint.h>
+#include "TouchPlatform.h"
+
+#ifdef TOUCHSLIDER_HOST_DRIVER    // Build against the driver stand-in (no ESP-IDF available), see TouchDriverHost.h
+  #include "TouchDriverHost.h"
+#else
+  #include <driver/touch_pad.h>
+  #include <soc/soc_caps.h>
+#endif
+
+/*********************** BACKEND SELECTION **********************/
+#if defined(SOC_TOUCH_VERSION_2) || (defined(SOC_TOUCH_SENSOR_VERSION) && (SOC_TOUCH_SENSOR_VERSION == 2))
+  #define TOUCHSLIDER_TOUCH_V2                  // ESP32-S2/S3 touch sensor, hardware baseline and denoise
+#endif
+
+/*********************** LIBRARY OPTIONS **********************/
+#define TOUCH_BASELINE_POLL_MS    10          // Time between two checks while waiting for the first measurement
+
+/*********************** CLASS DEFINITION **********************/
+
+class TouchDriver
+{
+  public:
+    typedef void (*ReadCallback)(uint16_t *raw_value, uint16_t *filtered_value);    // Filter output reading hook (v1 only)
+
+    // Peripheral control
+    static void init();                                                                 // Initialize the touch peripheral and the backend specific processing
+    static void configPad(touch_pad_t pad);                                             // Enable the measurement of a touch pad
+    static void start(uint8_t filterPeriod, ReadCallback readCallback);                 // Start filtering/measuring, the callback is only used by v1
+    static void stop();                                                                 // Stop filtering/measuring
+
+    // Measurement settings
+    static void setVoltage(uint8_t voltage);                                            // Set the reference voltage range (index, 0 is the default)
+    static void setMeasurementCycles(uint16_t measCycles);                              // Set the measurement time (v1) or the charge/discharge times (v2)
+    static uint8_t getNumVoltages();                                                    // Get the number of voltage ranges
+    static uint16_t getDefaultMeasurementCycles();                                      // Get the measurement cycles of the driver
+    static const uint16_t* getTuneMeasurementCycles(uint8_t &numCycles);                // Get the measurement cycles swept by the auto-tuner
+
+    // Readings
+    static uint32_t readRaw(touch_pad_t pad);                                           // Read the last raw measurement of a touch pad
+    static uint32_t readFiltered(touch_pad_t pad);                                      // Read the filtered value of a touch pad
+    static uint32_t readBaseline(touch_pad_t pad);                                      // Read the baseline (v1: filtered value, v2: hardware benchmark)
+    static bool waitBaseline(touch_pad_t pad, uint32_t timeoutMs);                      // Wait until the first measurement of a pad gives a baseline
+    static void setPadThreshold(touch_pad_t pad, uint32_t thresholdDelta);              // Program the per-channel threshold (v2 only, no-op on v1)
+
+    // Backend logic, independent of the hardware
+    static uint32_t thresholdFromBaseline(uint32_t baseline, uint8_t thresholdPercent); // Delta needed to consider the pad touched
+    static uint32_t touchDelta(uint32_t filteredValue, uint32_t baseline);              // Signal in the touch direction, 0 if the pad moves away from touch
+    static int32_t touchChange(uint32_t filteredValue, uint32_t baseline);              // Signed change from the baseline, positive towards touch
+    static bool isTouched(uint32_t filteredValue, uint32_t baseline, uint32_t thresholdDelta);  // Check if a pad is touched
+    static bool tracksBaseline();                                                       // True if the hardware keeps the baseline updated
+    static touch_pad_t mapGpioToTouchPad(gpio_num_t gpioPin);                           // Map the GPIO pin to the touch pad
+};
+#endif
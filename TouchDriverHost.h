@@ -0,0 +1,129 @@
+/*
+* Marcos Abraham Carballo Vazquez
+* Original Creation Date: Dicember 5, 2024
+* https://github.com/MarcosCarballoV/TouchSlider_ESP32
+* */
+
+#ifndef TOUCHDRIVERHOST_H
+#define TOUCHDRIVERHOST_H
+
+/**
+* Driver stand-in used when TOUCHSLIDER_HOST_DRIVER is defined. It replaces the ESP-IDF touch sensor driver
+* with plain arrays, so the backend logic in TouchDriver can be built and exercised on a host computer.
+*
+* By default the stand-in behaves like the ESP32 touch sensor (v1, value drops on touch). Define
+* TOUCHSLIDER_HOST_TOUCH_V2 to behave like the ESP32-S2/S3 touch sensor (v2, value rises on touch).
+*/
+/*********************** EXTERNAL LIBRARIES **********************/
+
+#include <stdint.h>
+
+/*********************** DRIVER TYPES **********************/
+#ifdef TOUCHSLIDER_HOST_TOUCH_V2
+  #define SOC_TOUCH_VERSION_2     1
+  #define SOC_TOUCH_SENSOR_NUM    15
+  #define TOUCH_PAD_MEASURE_CYCLE_DEFAULT   (500)       // Charge/discharge times
+#else
+  #define SOC_TOUCH_VERSION_1     1
+  #define SOC_TOUCH_SENSOR_NUM    10
+  #define TOUCH_PAD_MEASURE_CYCLE_DEFAULT   (0x7fff)    // 8 MHz cycles
+#endif
+
+typedef enum {
+  GPIO_NUM_NC = -1,
+  GPIO_NUM_0 = 0,
+  GPIO_NUM_1 = 1,
+  GPIO_NUM_2 = 2,
+  GPIO_NUM_3 = 3,
+  GPIO_NUM_4 = 4,
+  GPIO_NUM_5 = 5,
+  GPIO_NUM_6 = 6,
+  GPIO_NUM_7 = 7,
+  GPIO_NUM_8 = 8,
+  GPIO_NUM_9 = 9,
+  GPIO_NUM_10 = 10,
+  GPIO_NUM_11 = 11,
+  GPIO_NUM_12 = 12,
+  GPIO_NUM_13 = 13,
+  GPIO_NUM_14 = 14,
+  GPIO_NUM_15 = 15,
+  GPIO_NUM_16 = 16,
+  GPIO_NUM_17 = 17,
+  GPIO_NUM_18 = 18,
+  GPIO_NUM_19 = 19,
+  GPIO_NUM_20 = 20,
+  GPIO_NUM_21 = 21,
+  GPIO_NUM_22 = 22,
+  GPIO_NUM_23 = 23,
+  GPIO_NUM_24 = 24,
+  GPIO_NUM_25 = 25,
+  GPIO_NUM_26 = 26,
+  GPIO_NUM_27 = 27,
+  GPIO_NUM_28 = 28,
+  GPIO_NUM_29 = 29,
+  GPIO_NUM_30 = 30,
+  GPIO_NUM_31 = 31,
+  GPIO_NUM_32 = 32,
+  GPIO_NUM_33 = 33,
+  GPIO_NUM_34 = 34,
+  GPIO_NUM_35 = 35,
+  GPIO_NUM_36 = 36,
+  GPIO_NUM_37 = 37,
+  GPIO_NUM_38 = 38,
+  GPIO_NUM_39 = 39,
+  GPIO_NUM_40 = 40,
+  GPIO_NUM_41 = 41,
+  GPIO_NUM_42 = 42,
+  GPIO_NUM_43 = 43,
+  GPIO_NUM_44 = 44,
+  GPIO_NUM_45 = 45,
+  GPIO_NUM_46 = 46,
+  GPIO_NUM_47 = 47,
+  GPIO_NUM_48 = 48,
+  GPIO_NUM_MAX,
+} gpio_num_t;
+
+typedef enum {
+  TOUCH_PAD_NUM0,
+  TOUCH_PAD_NUM1,
+  TOUCH_PAD_NUM2,
+  TOUCH_PAD_NUM3,
+  TOUCH_PAD_NUM4,
+  TOUCH_PAD_NUM5,
+  TOUCH_PAD_NUM6,
+  TOUCH_PAD_NUM7,
+  TOUCH_PAD_NUM8,
+  TOUCH_PAD_NUM9,
+  TOUCH_PAD_NUM10,
+  TOUCH_PAD_NUM11,
+  TOUCH_PAD_NUM12,
+  TOUCH_PAD_NUM13,
+  TOUCH_PAD_NUM14,
+  TOUCH_PAD_MAX = SOC_TOUCH_SENSOR_NUM,
+} touch_pad_t;
+
+/*********************** CLASS DEFINITION **********************/
+
+class TouchDriverHost
+{
+  public:
+    static void setFiltered(touch_pad_t pad, uint32_t value) {_filtered[pad] = value;};   // Set the value the driver reports as filtered
+    static void setBaseline(touch_pad_t pad, uint32_t value) {_baseline[pad] = value;};   // Set the value the driver reports as benchmark (v2)
+    static bool isConfigured(touch_pad_t pad) {return _configured[pad];};                 // Check if the pad was configured by the backend
+    static uint32_t getThreshold(touch_pad_t pad) {return _threshold[pad];};              // Get the threshold programmed for the pad
+    static bool isRunning() {return _running;};                                           // Check if the measurement is running
+    static uint8_t getVoltage() {return _voltage;};                                       // Get the voltage range set
+    static uint16_t getMeasurementCycles() {return _measCycles;};                         // Get the measurement cycles set
+
+  private:
+    friend class TouchDriver;
+
+    static uint32_t _filtered[TOUCH_PAD_MAX];                         // Filtered value of each pad
+    static uint32_t _baseline[TOUCH_PAD_MAX];                         // Benchmark of each pad
+    static uint32_t _threshold[TOUCH_PAD_MAX];                        // Threshold programmed on each pad
+    static bool _configured[TOUCH_PAD_MAX];                           // Indicates whether the pad was configured
+    static bool _running;                                             // Indicates whether the measurement is running
+    static uint8_t _voltage;                                          // Voltage range set
+    static uint16_t _measCycles;                                      // Measurement cycles set
+};
+#endif
@@ -0,0 +1,269 @@
+#include "TouchGestureClassifier.h"
+
+/*********************** PUBLIC FUNCTIONS **********************/
+/**
+ * @brief Set a linear model, replacing the decision tree.
+ *
+ * Each class has a row of CLASSIFIER_FEATURES + 1 weights in Q8: the bias and one weight per feature, in the order of
+ * TouchClassifierFeature. The score of a class is bias + sum(weight * feature).
+ *
+ * @param weights numClasses rows of weights, declare them as a constant so they stay in flash.
+ * @param classIds Class id of each row, CLASSIFIER_NONE is not allowed.
+ * @param numClasses Number of classes.
+ */
+void TouchGestureClassifier::setLinearModel(const int16_t weights[], const uint8_t classIds[], uint8_t numClasses) {
+  _weights = weights;
+  _classIds = classIds;
+  _numClasses = numClasses;
+  _nodes = nullptr;
+  _numNodes = 0;
+}
+
+/**
+ * @brief Set a decision tree, replacing the linear model.
+ *
+ * @param nodes Nodes of the tree, the first one is the root. Declare them as a constant so they stay in flash.
+ * @param numNodes Number of nodes.
+ */
+void TouchGestureClassifier::setTreeModel(const TouchClassifierNode nodes[], uint8_t numNodes) {
+  _nodes = nodes;
+  _numNodes = numNodes;
+  _weights = nullptr;
+  _classIds = nullptr;
+  _numClasses = 0;
+}
+
+/**
+ * @brief Start a touch episode.
+ * @param scanIntervalMs Time between two scans, to convert the scans in time.
+ */
+void TouchGestureClassifier::begin(uint16_t scanIntervalMs) {
+  _scanIntervalMs = scanIntervalMs > 0 ? scanIntervalMs : 1;
+  _scans = 0;
+  _path = 0;
+  _peakStep = 0;
+  _direction = 0;
+  _reversals = 0;
+  _peakDelta = 0;
+  _widthSum = 0;
+  _maxContacts = 0;
+}
+
+/**
+ * @brief Accumulate a touched scan of the episode.
+ *
+ * The centroid is weighted by the delta of every pad, so a finger between two pads, or a weak edge pad that never
+ * reaches its threshold, still moves it. The pads must be in physical order, see addPosition() otherwise.
+ *
+ * @param deltas Signal of each slider pad in the touch direction (TouchDriver::touchDelta).
+ * @param thresholds Touch threshold of each slider pad, as a delta.
+ * @param numPads Number of slider pads.
+ * @param numContacts Separate contacts found on the scan.
+ */
+void TouchGestureClassifier::addScan(const uint32_t deltas[], const uint32_t thresholds[], uint8_t numPads, uint8_t numContacts) {
+  uint64_t sum = 0;
+  uint64_t weighted = 0;
+  uint8_t width = 0;
+  uint32_t peakPercent = 0;
+  for (uint8_t i = 0; i < numPads; ++i) {
+    sum += deltas[i];
+    weighted += static_cast<uint64_t>(deltas[i]) * i;
+    if (thresholds[i] > 0) {
+      uint32_t percent = static_cast<uint32_t>(static_cast<uint64_t>(deltas[i]) * 100 / thresholds[i]);
+      if (percent > peakPercent) peakPercent = percent;
+      if (deltas[i] >= thresholds[i]) ++width;
+    }
+  }
+  if (sum == 0)
+    return;
+
+  int16_t position = numPads > 1 ? static_cast<int16_t>(weighted * CLASSIFIER_POSITION_SCALE / ((numPads - 1) * sum)) : CLASSIFIER_POSITION_SCALE / 2;
+  accumulate(position, peakPercent, width, numContacts);
+}
+
+/**
+ * @brief Accumulate a touched scan of the episode with a position found by the slider.
+ *
+ * Used when the pads are not in physical order, for example the channels of an interleaved slider, where the segment
+ * decoder gives the position.
+ *
+ * @param position Position of the touch, from 0 to maxPosition.
+ * @param maxPosition Position of the center of the last pad or segment, 0 for a slider of one position.
+ * @param peakPercent Highest delta of the scan, percentage of its touch threshold.
+ * @param width Touched pads or segments.
+ * @param numContacts Separate contacts found on the scan.
+ */
+void TouchGestureClassifier::addPosition(uint16_t position, uint16_t maxPosition, uint32_t peakPercent, uint8_t width, uint8_t numContacts) {
+  if (position > maxPosition)
+    position = maxPosition;
+  int16_t scaled = maxPosition > 0 ? static_cast<int16_t>(static_cast<uint32_t>(position) * CLASSIFIER_POSITION_SCALE / maxPosition) : CLASSIFIER_POSITION_SCALE / 2;
+  accumulate(scaled, peakPercent, width, numContacts);
+}
+
+/**
+ * @brief Finish the episode, extract the features and classify them.
+ *
+ * The class is queued and the callback is called. If the queue is full the new class is lost and only reaches the
+ * callback, so the slider timer only writes the tail and getClass() only writes the head. Episodes classified as
+ * CLASSIFIER_NONE are not reported.
+ *
+ * @return The class of the episode, or CLASSIFIER_NONE.
+ */
+uint8_t TouchGestureClassifier::end() {
+  if (_scans == 0)
+    return CLASSIFIER_NONE;
+
+  int32_t durationMs = static_cast<int32_t>(_scans) * _scanIntervalMs;
+  int32_t displacement = _lastPosition - _startPosition;
+  _features[FEATURE_DURATION] = saturate(durationMs);
+  _features[FEATURE_START] = _startPosition;
+  _features[FEATURE_END] = _lastPosition;
+  _features[FEATURE_DISPLACEMENT] = saturate(displacement);
+  _features[FEATURE_PATH] = saturate(_path > INT16_MAX ? INT16_MAX : _path);
+  _features[FEATURE_VELOCITY] = saturate(displacement * 1000 / durationMs);
+  _features[FEATURE_PEAK_VELOCITY] = saturate(static_cast<int32_t>(_peakStep) * 1000 / _scanIntervalMs);
+  _features[FEATURE_REVERSALS] = _reversals;
+  _features[FEATURE_PEAK_DELTA] = saturate(_peakDelta > INT16_MAX ? INT16_MAX : _peakDelta);
+  _features[FEATURE_MEAN_WIDTH] = saturate(static_cast<int32_t>(_widthSum * 16 / _scans));
+  _features[FEATURE_MAX_CONTACTS] = _maxContacts;
+  _scans = 0;
+
+  if (_featureCallback != nullptr)
+    _featureCallback(_features);
+
+  uint8_t classId = classify(_features);
+  if (classId == CLASSIFIER_NONE)
+    return CLASSIFIER_NONE;
+
+  uint8_t nextTail = (_queueTail + 1) % CLASSIFIER_QUEUE_SIZE;
+  if (nextTail != _queueHead) {   // Queue full, drop the newest class
+    _queue[_queueTail] = classId;
+    _queueTail = nextTail;
+  }
+
+  if (_callback != nullptr)
+    _callback(classId);
+  return classId;
+}
+
+/**
+ * @brief Score a feature vector with the model.
+ *
+ * Can be used without the slider, for example to check a model against recorded traces.
+ *
+ * @param features CLASSIFIER_FEATURES features, in the order of TouchClassifierFeature.
+ * @return The class, or CLASSIFIER_NONE if there is no model or no class has a positive score.
+ */
+uint8_t TouchGestureClassifier::classify(const int16_t features[]) {
+  if (_nodes != nullptr)
+    return classifyTree(features);
+  if (_weights != nullptr)
+    return classifyLinear(features);
+  return CLASSIFIER_NONE;
+}
+
+/**
+ * @brief Get the next classified episode.
+ * @return The class id, or CLASSIFIER_NONE if there is none.
+ */
+uint8_t TouchGestureClassifier::getClass() {
+  if (_queueHead == _queueTail)
+    return CLASSIFIER_NONE;
+
+  uint8_t classId = _queue[_queueHead];
+  _queueHead = (_queueHead + 1) % CLASSIFIER_QUEUE_SIZE;
+  return classId;
+}
+
+/*********************** PRIVATE FUNCTIONS **********************/
+/**
+ * @brief Accumulate the centroid and the statistics of a touched scan.
+ * @param position Centroid of the scan, per-mille of the slider.
+ * @param peakPercent Highest delta of the scan, percentage of its touch threshold.
+ * @param width Touched pads of the scan.
+ * @param numContacts Separate contacts found on the scan.
+ */
+void TouchGestureClassifier::accumulate(int16_t position, uint32_t peakPercent, uint8_t width, uint8_t numContacts) {
+  if (_scans == 0) {
+    _startPosition = position;
+    _extremePosition = position;
+  } else {
+    uint16_t step = position > _lastPosition ? position - _lastPosition : _lastPosition - position;
+    _path += step;
+    if (step > _peakStep) _peakStep = step;
+
+    int16_t travel = position - _extremePosition;
+    if (_direction == 0) {    // Wait for a clear movement to know the direction
+      if (travel >= CLASSIFIER_REVERSAL_MIN || travel <= -CLASSIFIER_REVERSAL_MIN) {
+        _direction = travel > 0 ? 1 : -1;
+        _extremePosition = position;
+      }
+    } else if (travel * _direction > 0) {   // Still moving in the same direction
+      _extremePosition = position;
+    } else if (-travel * _direction >= CLASSIFIER_REVERSAL_MIN) {
+      if (_reversals < UINT8_MAX) ++_reversals;
+      _direction = -_direction;
+      _extremePosition = position;
+    }
+  }
+  _lastPosition = position;
+
+  if (peakPercent > _peakDelta) _peakDelta = peakPercent;
+  _widthSum += width;
+  if (numContacts > _maxContacts) _maxContacts = numContacts;
+  if (_scans < UINT16_MAX) ++_scans;
+}
+
+/**
+ * @brief Score the classes of the linear model.
+ * @param features The feature vector.
+ * @return The class with the highest positive score, or CLASSIFIER_NONE.
+ */
+uint8_t TouchGestureClassifier::classifyLinear(const int16_t features[]) {
+  uint8_t best = CLASSIFIER_NONE;
+  int64_t bestScore = 0;
+  for (uint8_t c = 0; c < _numClasses; ++c) {
+    const int16_t *row = _weights + static_cast<uint16_t>(c) * (CLASSIFIER_FEATURES + 1);
+    int64_t score = row[0];
+    for (uint8_t i = 0; i < CLASSIFIER_FEATURES; ++i) {
+      score += static_cast<int32_t>(row[i + 1]) * features[i];
+    }
+    if (score > bestScore) {
+      bestScore = score;
+      best = _classIds[c];
+    }
+  }
+  return best;
+}
+
+/**
+ * @brief Walk the decision tree from the root to a leaf.
+ *
+ * The walk stops after numNodes nodes, so a malformed table (a loop or an index out of range) gives CLASSIFIER_NONE.
+ *
+ * @param features The feature vector.
+ * @return The class of the leaf, or CLASSIFIER_NONE.
+ */
+uint8_t TouchGestureClassifier::classifyTree(const int16_t features[]) {
+  uint8_t index = 0;
+  for (uint8_t visited = 0; visited < _numNodes && index < _numNodes; ++visited) {
+    const TouchClassifierNode &node = _nodes[index];
+    if (node.feature == CLASSIFIER_LEAF)
+      return node.classId;
+    if (node.feature >= CLASSIFIER_FEATURES)
+      return CLASSIFIER_NONE;
+    index = features[node.feature] <= node.threshold ? node.left : node.right;
+  }
+  return CLASSIFIER_NONE;
+}
+
+/**
+ * @brief Clamp a value to the range of int16_t.
+ * @param value The value.
+ * @return The clamped value.
+ */
+int16_t TouchGestureClassifier::saturate(int32_t value) {
+  if (value > INT16_MAX) return INT16_MAX;
+  if (value < INT16_MIN) return INT16_MIN;
+  return static_cast<int16_t>(value);
+}
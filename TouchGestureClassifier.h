@@ -0,0 +1,134 @@
+/*
+* Marcos Abraham Carballo Vazquez
+* Original Creation Date: Dicember 5, 2024
+* https://github.com/MarcosCarballoV/TouchSlider_ESP32
+* */
+
+#ifndef TOUCHGESTURECLASSIFIER_H
+#define TOUCHGESTURECLASSIFIER_H
+
+/**
+* Fixed-point classifier of touch episodes, for panels where the rules of the slider misfire (thick glass, weak edges,
+* adjacent pads lighting up together).
+*
+* While the slider is touched, the classifier follows the centroid of the pad deltas (weighted by the signal of every
+* pad, not only the touched ones) and accumulates a few statistics. On release they become a feature vector of
+* CLASSIFIER_FEATURES int16_t values and a model from a constant table scores the gesture classes:
+*   - Linear model: one row per class, {bias, w0, ... wN-1} in Q8. The class with the highest score wins, if it is
+*     positive, so a rejection class is not needed.
+*   - Decision tree: nodes compare one feature with a threshold, the leaves hold the class id.
+* Nothing is allocated, the episode state is a few integers and the inference takes a few microseconds.
+*
+* Positions are in per-mille of the slider length (0 is the center of the first pad, 1000 the center of the last one),
+* so a model works on sliders with a different number of pads. On an interleaved slider the channels are not in
+* physical order, so the slider reports the decoded segment position with addPosition() instead of the deltas.
+*
+* To build a model, record the features of each episode with setFeatureCallback(), label them and train the linear
+* model or the tree offline.
+*
+* Example, a tree generated from recorded traces:
+*   const TouchClassifierNode tree[] = {
+*     // feature, class, threshold, left (<=), right (>)
+*     {FEATURE_PATH,         0,   150, 1, 2},       // 0: barely moved?
+*     {CLASSIFIER_LEAF,      1,     0, 0, 0},       // 1: tap
+*     {FEATURE_DISPLACEMENT, 0,     0, 3, 4},       // 2: direction
+*     {CLASSIFIER_LEAF,      2,     0, 0, 0},       // 3: swipe towards the first pad
+*     {CLASSIFIER_LEAF,      3,     0, 0, 0}        // 4: swipe towards the last pad
+*   };
+*/
+/*********************** EXTERNAL LIBRARIES **********************/
+
+#include <stdint.h>
+
+/*********************** LIBRARY OPTIONS **********************/
+#define CLASSIFIER_NONE           0           // No class, do not use it as a class id
+#define CLASSIFIER_LEAF           0xFF        // Feature of a leaf node of the decision tree
+#define CLASSIFIER_POSITION_SCALE 1000        // Position of the center of the last pad
+#define CLASSIFIER_REVERSAL_MIN   60          // Movement in per-mille to count a change of direction, filters the jitter of the centroid
+#define CLASSIFIER_QUEUE_SIZE     8           // Classified episodes waiting to be read, plus one free slot
+
+/*********************** TYPES **********************/
+enum TouchClassifierFeature : uint8_t {
+  FEATURE_DURATION = 0,           // Time touched in ms
+  FEATURE_START,                  // Centroid of the first scan, per-mille of the slider
+  FEATURE_END,                    // Centroid of the last scan, per-mille of the slider
+  FEATURE_DISPLACEMENT,           // End - start, positive towards the last pad
+  FEATURE_PATH,                   // Total movement of the centroid, per-mille of the slider
+  FEATURE_VELOCITY,               // Mean velocity, per-mille of the slider per second
+  FEATURE_PEAK_VELOCITY,          // Highest speed between two scans, per-mille of the slider per second
+  FEATURE_REVERSALS,              // Changes of direction
+  FEATURE_PEAK_DELTA,             // Highest pad delta, percentage of the touch threshold of the pad
+  FEATURE_MEAN_WIDTH,             // Mean number of touched pads (Q4)
+  FEATURE_MAX_CONTACTS,           // Most separate contacts seen (1 or 2)
+  CLASSIFIER_FEATURES             // Number of features
+};
+
+struct TouchClassifierNode {
+  uint8_t feature;                // Feature compared, CLASSIFIER_LEAF for a leaf
+  uint8_t classId;                // Class of a leaf
+  int16_t threshold;              // Go to the left node if the feature is <= threshold, to the right one otherwise
+  uint8_t left;                   // Index of the left node
+  uint8_t right;                  // Index of the right node
+};
+
+/*********************** CLASS DEFINITION **********************/
+
+class TouchGestureClassifier
+{
+  public:
+    typedef void (*ClassCallback)(uint8_t classId);                               // Called when an episode is classified
+    typedef void (*FeatureCallback)(const int16_t features[]);                    // Called with the features of every episode, to record traces
+
+    // Model, the tables are not copied and must outlive the classifier
+    void setLinearModel(const int16_t weights[], const uint8_t classIds[], uint8_t numClasses);   // Set a linear model, numClasses rows of CLASSIFIER_FEATURES + 1 weights
+    void setTreeModel(const TouchClassifierNode nodes[], uint8_t numNodes);       // Set a decision tree, the root is the first node
+    void setCallback(ClassCallback callback) {_callback = callback;};             // Set the callback called when an episode is classified
+    void setFeatureCallback(FeatureCallback callback) {_featureCallback = callback;};   // Set the callback called with the features of every episode
+
+    // Input, called by TouchSlider
+    void begin(uint16_t scanIntervalMs);                                          // Start a touch episode
+    void addScan(const uint32_t deltas[], const uint32_t thresholds[], uint8_t numPads, uint8_t numContacts);   // Accumulate a touched scan, the pads are in physical order
+    void addPosition(uint16_t position, uint16_t maxPosition, uint32_t peakPercent, uint8_t width, uint8_t numContacts);   // Accumulate a touched scan with a position found by the slider
+    uint8_t end();                                                                // Finish the episode and classify it
+
+    // Inference
+    uint8_t classify(const int16_t features[]);                                   // Score a feature vector with the model
+    const int16_t* getFeatures() {return _features;};                            // Get the features of the last episode
+
+    // Getters
+    uint8_t getClass();                                                           // Get the next classified episode, or CLASSIFIER_NONE
+
+  private:
+    const int16_t* _weights = nullptr;                                // Linear model, numClasses rows
+    const uint8_t* _classIds = nullptr;                               // Class id of each row of the linear model
+    uint8_t _numClasses = 0;                                          // Rows of the linear model
+    const TouchClassifierNode* _nodes = nullptr;                      // Decision tree
+    uint8_t _numNodes = 0;                                            // Nodes of the decision tree
+
+    // Episode state
+    uint16_t _scanIntervalMs = 50;                                    // Time between two scans
+    uint16_t _scans = 0;                                              // Touched scans of the episode
+    int16_t _startPosition = 0;                                       // Centroid of the first scan
+    int16_t _lastPosition = 0;                                        // Centroid of the previous scan
+    int16_t _extremePosition = 0;                                     // Furthest centroid in the current direction
+    int8_t _direction = 0;                                            // Current direction of the movement (-1, 0, 1)
+    uint32_t _path = 0;                                               // Total movement of the centroid
+    uint16_t _peakStep = 0;                                           // Highest movement between two scans
+    uint8_t _reversals = 0;                                           // Changes of direction
+    uint32_t _peakDelta = 0;                                          // Highest delta, percentage of the threshold
+    uint32_t _widthSum = 0;                                           // Sum of the touched pads of every scan
+    uint8_t _maxContacts = 0;                                         // Most separate contacts seen
+    int16_t _features[CLASSIFIER_FEATURES] = {};                      // Features of the last episode
+
+    volatile uint8_t _queue[CLASSIFIER_QUEUE_SIZE];                   // Classified episodes
+    volatile uint8_t _queueHead = 0;                                  // Next class to read
+    volatile uint8_t _queueTail = 0;                                  // Next free position
+    ClassCallback _callback = nullptr;                                // Callback called when an episode is classified
+    FeatureCallback _featureCallback = nullptr;                       // Callback called with the features of every episode
+
+    void accumulate(int16_t position, uint32_t peakPercent, uint8_t width, uint8_t numContacts);   // Accumulate the centroid of a touched scan
+    uint8_t classifyLinear(const int16_t features[]);                 // Score the classes of the linear model
+    uint8_t classifyTree(const int16_t features[]);                   // Walk the decision tree
+    static int16_t saturate(int32_t value);                           // Clamp a value to int16_t
+};
+#endif
@@ -0,0 +1,142 @@
+#include "TouchGestureRecognizer.h"
+
+/*********************** PUBLIC FUNCTIONS **********************/
+/**
+ * @brief Set the pattern table.
+ *
+ * The table is not copied, declare it as a constant so it stays in flash. The length of each pattern and the patterns
+ * that start with each stroke are computed here, so feeding a stroke does not need to scan the table.
+ *
+ * @param patterns Array of patterns.
+ * @param numPatterns Number of patterns, limited to GESTURE_MAX_PATTERNS.
+ */
+void TouchGestureRecognizer::setPatterns(const TouchGesturePattern patterns[], uint8_t numPatterns) {
+  if (numPatterns > GESTURE_MAX_PATTERNS)
+    numPatterns = GESTURE_MAX_PATTERNS;
+
+  _patterns = patterns;
+  _numPatterns = numPatterns;
+  for (uint8_t stroke = 0; stroke < STROKE_MAX; ++stroke) {
+    _startMask[stroke] = 0;
+  }
+
+  for (uint8_t i = 0; i < _numPatterns; ++i) {
+    uint8_t numSteps = 0;
+    while (numSteps < GESTURE_MAX_STEPS && patterns[i].steps[numSteps] != STROKE_NONE) {
+      ++numSteps;
+    }
+    _numSteps[i] = numSteps;
+
+    uint8_t firstStroke = patterns[i].steps[0] & 0x7F;
+    if (numSteps > 0 && firstStroke < STROKE_MAX)
+      _startMask[firstStroke] |= 1UL << i;
+  }
+  reset();
+}
+
+/**
+ * @brief Advance the patterns with a stroke.
+ *
+ * A pattern in progress moves to its next step if the stroke matches it, stays on its step if the stroke repeats a
+ * GESTURE_REPEAT step or is in its ignore mask, and is dropped otherwise. Then the patterns that start with the stroke
+ * and were not in progress are started.
+ *
+ * @param stroke The stroke reported by the slider.
+ */
+void TouchGestureRecognizer::feed(TouchStroke stroke) {
+  if (_patterns == nullptr || stroke == STROKE_NONE || stroke >= STROKE_MAX)
+    return;
+
+  uint32_t active = _activeMask;
+  while (active != 0) {   // Visit only the patterns in progress
+    uint8_t i = __builtin_ctz(active);
+    active &= active - 1;
+
+    const TouchGesturePattern &pattern = _patterns[i];
+    uint8_t progress = _progress[i];
+    uint8_t previousStep = pattern.steps[progress - 1];
+
+    if ((pattern.steps[progress] & 0x7F) == stroke) {
+      _progress[i] = progress + 1;
+      _gap[i] = 0;
+      if (_progress[i] >= _numSteps[i])
+        complete(i);
+    } else if ((previousStep & 0x80) && (previousStep & 0x7F) == stroke) {
+      _gap[i] = 0;    // Repeated stroke, stay on the same step
+    } else if (!(pattern.ignoreMask & STROKE_BIT(stroke))) {
+      _activeMask &= ~(1UL << i);
+    }
+  }
+
+  uint32_t start = _startMask[stroke] & ~_activeMask;
+  while (start != 0) {    // Start the patterns that begin with this stroke
+    uint8_t i = __builtin_ctz(start);
+    start &= start - 1;
+
+    _progress[i] = 1;
+    _gap[i] = 0;
+    _activeMask |= 1UL << i;
+    if (_numSteps[i] == 1)
+      complete(i);
+  }
+}
+
+/**
+ * @brief Advance the gap counters of the patterns in progress and drop the ones that waited too long.
+ */
+void TouchGestureRecognizer::tick() {
+  uint32_t active = _activeMask;
+  while (active != 0) {
+    uint8_t i = __builtin_ctz(active);
+    active &= active - 1;
+
+    if (_gap[i] < UINT8_MAX)
+      _gap[i]++;
+    if (_patterns[i].maxGapScans != 0 && _gap[i] > _patterns[i].maxGapScans)
+      _activeMask &= ~(1UL << i);
+  }
+}
+
+/**
+ * @brief Drop the patterns in progress.
+ */
+void TouchGestureRecognizer::reset() {
+  _activeMask = 0;
+}
+
+/**
+ * @brief Get the next recognized gesture and remove it from the queue.
+ * @return The id of the gesture, or GESTURE_NONE if no gesture was recognized.
+ */
+uint8_t TouchGestureRecognizer::getGesture() {
+  if (_queueHead == _queueTail)
+    return GESTURE_NONE;
+
+  uint8_t gestureId = _queue[_queueHead];
+  _queueHead = (_queueHead + 1) % GESTURE_QUEUE_SIZE;
+  return gestureId;
+}
+
+/*********************** PRIVATE FUNCTIONS **********************/
+/**
+ * @brief Report a recognized pattern.
+ *
+ * The pattern is dropped, its id is queued and the callback is called. If the queue is full the new gesture is lost and
+ * only reaches the callback: the scan timer only writes the tail and the application only writes the head, so the
+ * queue needs no lock.
+ *
+ * @param patternIndex Index of the pattern in the table.
+ */
+void TouchGestureRecognizer::complete(uint8_t patternIndex) {
+  _activeMask &= ~(1UL << patternIndex);
+
+  uint8_t gestureId = _patterns[patternIndex].id;
+  uint8_t nextTail = (_queueTail + 1) % GESTURE_QUEUE_SIZE;
+  if (nextTail != _queueHead) {   // Queue full, drop the newest gesture
+    _queue[_queueTail] = gestureId;
+    _queueTail = nextTail;
+  }
+
+  if (_callback != nullptr)
+    _callback(gestureId);
+}
@@ -0,0 +1,101 @@
+/*
+* Marcos Abraham Carballo Vazquez
+* Original Creation Date: Dicember 5, 2024
+* https://github.com/MarcosCarballoV/TouchSlider_ESP32
+* */
+
+#ifndef TOUCHGESTURERECOGNIZER_H
+#define TOUCHGESTURERECOGNIZER_H
+
+/**
+* Table-driven recognizer for multi-stroke gestures.
+*
+* The slider reports every stroke (touch on an edge or in the middle, hold, swipe up, swipe down, release) to the
+* recognizer. Each gesture is declared as a pattern of strokes in a constant table, usually in flash, and every
+* pattern runs as a small state machine: one byte of progress and one byte of gap counter. Only the patterns in
+* progress are visited on each scan, so the cost is bounded by the number of patterns even with dozens of them.
+*
+* Example, declared at compile time:
+*   const TouchGesturePattern gestures[] = {
+*     // id, max scans between strokes, ignored strokes, strokes
+*     {1, 10, 0,                         {GESTURE_REPEAT(STROKE_SWIPE_UP), STROKE_SWIPE_DOWN}},                 // Up then down
+*     {2, 8,  0,                         {STROKE_TOUCH_TOP, STROKE_RELEASE, STROKE_TOUCH_TOP, STROKE_RELEASE}}, // Double tap on top edge
+*     {3, 20, STROKE_BIT(STROKE_HOLD),   {STROKE_TOUCH_BOT, STROKE_HOLD, STROKE_SWIPE_UP}}                      // Hold bottom then swipe
+*   };
+*/
+/*********************** EXTERNAL LIBRARIES **********************/
+
+#include <stdint.h>
+
+/*********************** LIBRARY OPTIONS **********************/
+#define GESTURE_MAX_PATTERNS      32          // Maximum number of patterns (one bit per pattern in the active mask)
+#define GESTURE_MAX_STEPS         6           // Maximum number of strokes per pattern
+#define GESTURE_QUEUE_SIZE        8           // Recognized gestures waiting to be read, plus one free slot
+#define GESTURE_NONE              0           // No gesture recognized, do not use it as a pattern id
+
+#define GESTURE_REPEAT(stroke)    ((stroke) | 0x80)     // The stroke can repeat before the next step
+#define STROKE_BIT(stroke)        (1U << (stroke))      // Bit of a stroke in the ignore mask
+
+/*********************** TYPES **********************/
+enum TouchStroke : uint8_t {
+  STROKE_NONE = 0,                // End of the pattern
+  STROKE_TOUCH_BOT,               // First touch on the bottom pad only
+  STROKE_TOUCH_TOP,               // First touch on the top pad only
+  STROKE_TOUCH_MID,               // First touch anywhere else
+  STROKE_HOLD,                    // Touch held without swiping
+  STROKE_SWIPE_UP,                // Swipe up
+  STROKE_SWIPE_DOWN,              // Swipe down
+  STROKE_RELEASE,                 // The finger left the slider
+  STROKE_PINCH,                   // Two fingers moved closer
+  STROKE_SPREAD,                  // Two fingers moved apart
+  STROKE_TWO_FINGER_SWIPE_UP,     // Two fingers swiped up
+  STROKE_TWO_FINGER_SWIPE_DOWN,   // Two fingers swiped down
+  STROKE_MAX                      // Up to 16 strokes, the ignore mask has one bit per stroke
+};
+
+struct TouchGesturePattern {
+  uint8_t id;                     // Id reported when the pattern is recognized
+  uint8_t maxGapScans;            // Maximum scans between two strokes, 0 for no limit
+  uint16_t ignoreMask;            // Strokes that do not break the pattern (STROKE_BIT)
+  uint8_t steps[GESTURE_MAX_STEPS];   // Strokes, ended by STROKE_NONE or by the end of the array
+};
+
+/*********************** CLASS DEFINITION **********************/
+
+class TouchGestureRecognizer
+{
+  public:
+    typedef void (*GestureCallback)(uint8_t gestureId);                           // Called when a gesture is recognized
+
+    // Configuration
+    void setPatterns(const TouchGesturePattern patterns[], uint8_t numPatterns);  // Set the pattern table, it is not copied and must outlive the recognizer
+    void setCallback(GestureCallback callback) {_callback = callback;};           // Set the callback called when a gesture is recognized
+    void setHoldScans(uint8_t holdScans) {_holdScans = holdScans;};              // Set the scans without swiping to report STROKE_HOLD
+    uint8_t getHoldScans() {return _holdScans;};                                 // Get the scans without swiping to report STROKE_HOLD
+
+    // Input, called by TouchSlider
+    void feed(TouchStroke stroke);                                                // Advance the patterns with a stroke
+    void tick();                                                                  // Advance the gap counters, called once per scan
+    void reset();                                                                 // Drop the patterns in progress
+
+    // Getters
+    uint8_t getGesture();                                                         // Get the next recognized gesture id, or GESTURE_NONE
+
+  private:
+    const TouchGesturePattern* _patterns = nullptr;                   // Pattern table
+    uint8_t _numPatterns = 0;                                         // Number of patterns
+    uint8_t _numSteps[GESTURE_MAX_PATTERNS];                          // Number of strokes of each pattern
+    uint32_t _startMask[STROKE_MAX];                                  // Patterns that start with each stroke
+    uint32_t _activeMask = 0;                                         // Patterns in progress
+    uint8_t _progress[GESTURE_MAX_PATTERNS];                          // Strokes matched by each pattern
+    uint8_t _gap[GESTURE_MAX_PATTERNS];                               // Scans since the last matched stroke of each pattern
+    uint8_t _holdScans = 10;                                          // Scans without swiping to report STROKE_HOLD
+
+    volatile uint8_t _queue[GESTURE_QUEUE_SIZE];                      // Recognized gestures
+    volatile uint8_t _queueHead = 0;                                  // Next gesture to read
+    volatile uint8_t _queueTail = 0;                                  // Next free position
+    GestureCallback _callback = nullptr;                              // Callback called when a gesture is recognized
+
+    void complete(uint8_t patternIndex);                              // Report a recognized pattern
+};
+#endif
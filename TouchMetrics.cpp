@@ -0,0 +1,237 @@
+#include "TouchMetrics.h"
+
+/*********************** LOCAL FUNCTIONS **********************/
+// Little-endian writers/readers of the frame fields
+static void putU16(uint8_t *&cursor, uint16_t value) {
+  *cursor++ = value & 0xFF;
+  *cursor++ = value >> 8;
+}
+
+static void putU32(uint8_t *&cursor, uint32_t value) {
+  for (uint8_t i = 0; i < 4; ++i) {
+    *cursor++ = (value >> (8 * i)) & 0xFF;
+  }
+}
+
+static uint16_t getU16(const uint8_t *&cursor) {
+  uint16_t value = cursor[0] | (cursor[1] << 8);
+  cursor += 2;
+  return value;
+}
+
+static uint32_t getU32(const uint8_t *&cursor) {
+  uint32_t value = 0;
+  for (uint8_t i = 0; i < 4; ++i) {
+    value |= static_cast<uint32_t>(cursor[i]) << (8 * i);
+  }
+  cursor += 4;
+  return value;
+}
+
+static const size_t FRAME_HEADER_SIZE = 12;                                 // Magic, version, numPads, sequence, uptime
+static const size_t FRAME_FIXED_SIZE = FRAME_HEADER_SIZE + METRIC_COUNT * 4 + 3 * 4 + 2 * 2;
+static const size_t FRAME_PAD_SIZE = 11;                                    // pad, baseline, filtered, noise
+static const size_t FRAME_CRC_SIZE = 2;
+
+/*********************** RECORDING **********************/
+/**
+ * @brief Record the interval between two scans.
+ * @param intervalUs Measured interval in us.
+ * @param nominalUs Configured interval in us.
+ */
+void TouchMetrics::recordScan(uint32_t intervalUs, uint32_t nominalUs) {
+  _counters[METRIC_SCANS]++;
+  if (intervalUs < _scanIntervalMinUs) _scanIntervalMinUs = intervalUs;
+  if (intervalUs > _scanIntervalMaxUs) _scanIntervalMaxUs = intervalUs;
+  _scanJitterSumUs += intervalUs > nominalUs ? intervalUs - nominalUs : nominalUs - intervalUs;
+  _scanWindowCount++;
+}
+
+/**
+ * @brief Record the state of a pad.
+ *
+ * The noise is the mean absolute change of the filtered value between two scans, only while the pad is not touched.
+ *
+ * @param pad Touch pad number.
+ * @param baseline Untouched value of the pad.
+ * @param filtered Filtered value of the pad.
+ * @param touched Indicates whether the pad is touched.
+ */
+void TouchMetrics::recordPad(uint8_t pad, uint32_t baseline, uint32_t filtered, bool touched) {
+  if (pad >= METRICS_MAX_PADS)
+    return;
+
+  uint16_t padBit = 1U << pad;
+  if (!(_padMask & padBit)) {   // First reading of the pad
+    _padMask |= padBit;
+    _padNoise[pad] = 0;
+  } else if (!touched) {
+    uint32_t change = filtered > _padFiltered[pad] ? filtered - _padFiltered[pad] : _padFiltered[pad] - filtered;
+    int32_t sample = change > (UINT16_MAX >> 4) ? UINT16_MAX : change << 4;
+    int32_t noise = _padNoise[pad] + ((sample - _padNoise[pad]) >> METRICS_NOISE_SHIFT);
+    _padNoise[pad] = noise;
+  }
+  _padBaseline[pad] = baseline;
+  _padFiltered[pad] = filtered;
+}
+
+/**
+ * @brief Record the common-mode compensation of a scan.
+ * @param basisPoints Movement of the reference pad in 0.01 % of its baseline, positive towards touch.
+ */
+void TouchMetrics::recordCommonMode(int16_t basisPoints) {
+  _commonMode = basisPoints;
+  uint16_t magnitude = basisPoints < 0 ? -static_cast<int32_t>(basisPoints) : basisPoints;
+  if (magnitude > _commonModePeak) _commonModePeak = magnitude;
+}
+
+/**
+ * @brief Reset every metric.
+ */
+void TouchMetrics::reset() {
+  for (uint8_t i = 0; i < METRIC_COUNT; ++i) {
+    _counters[i] = 0;
+  }
+  _sequence = 0;
+  _scanIntervalMinUs = UINT32_MAX;
+  _scanIntervalMaxUs = 0;
+  _scanJitterSumUs = 0;
+  _scanWindowCount = 0;
+  _commonMode = 0;
+  _commonModePeak = 0;
+  _padMask = 0;
+}
+
+/*********************** FRAMES **********************/
+/**
+ * @brief Encode a telemetry frame and start a new scan jitter window.
+ * @param buffer Buffer for the frame, METRICS_FRAME_MAX_SIZE bytes are always enough.
+ * @param size Size of the buffer.
+ * @param uptimeMs Time of the frame in ms.
+ * @return The length of the frame, or 0 if the buffer is too small.
+ */
+size_t TouchMetrics::encodeFrame(uint8_t buffer[], size_t size, uint32_t uptimeMs) {
+  uint8_t numPads = 0;
+  for (uint8_t pad = 0; pad < METRICS_MAX_PADS; ++pad) {
+    if (_padMask & (1U << pad)) numPads++;
+  }
+
+  size_t length = FRAME_FIXED_SIZE + numPads * FRAME_PAD_SIZE + FRAME_CRC_SIZE;
+  if (size < length)
+    return 0;
+
+  uint8_t *cursor = buffer;
+  *cursor++ = 'T';
+  *cursor++ = 'M';
+  *cursor++ = METRICS_FRAME_VERSION;
+  *cursor++ = numPads;
+  putU32(cursor, _sequence++);
+  putU32(cursor, uptimeMs);
+  for (uint8_t i = 0; i < METRIC_COUNT; ++i) {
+    putU32(cursor, _counters[i]);
+  }
+  putU32(cursor, _scanWindowCount > 0 ? _scanIntervalMinUs : 0);
+  putU32(cursor, _scanIntervalMaxUs);
+  putU32(cursor, _scanWindowCount > 0 ? static_cast<uint32_t>(_scanJitterSumUs / _scanWindowCount) : 0);
+  putU16(cursor, static_cast<uint16_t>(_commonMode));
+  putU16(cursor, _commonModePeak);
+
+  for (uint8_t pad = 0; pad < METRICS_MAX_PADS; ++pad) {
+    if (_padMask & (1U << pad)) {
+      *cursor++ = pad;
+      putU32(cursor, _padBaseline[pad]);
+      putU32(cursor, _padFiltered[pad]);
+      putU16(cursor, _padNoise[pad]);
+    }
+  }
+  putU16(cursor, crc16(buffer, cursor - buffer));
+
+  _scanIntervalMinUs = UINT32_MAX;    // Start a new jitter window
+  _scanIntervalMaxUs = 0;
+  _scanJitterSumUs = 0;
+  _scanWindowCount = 0;
+  _commonModePeak = 0;
+  return length;
+}
+
+/**
+ * @brief Decode and check a telemetry frame.
+ * @param buffer The frame.
+ * @param length Length of the frame.
+ * @param snapshot Decoded metrics.
+ * @retval true: The frame is valid (magic, version, length and CRC)
+ */
+bool TouchMetrics::decodeFrame(const uint8_t buffer[], size_t length, TouchMetricsSnapshot &snapshot) {
+  if (length < FRAME_FIXED_SIZE + FRAME_CRC_SIZE)
+    return false;
+  if (buffer[0] != 'T' || buffer[1] != 'M' || buffer[2] != METRICS_FRAME_VERSION)
+    return false;
+
+  uint8_t numPads = buffer[3];
+  if (numPads > METRICS_MAX_PADS || length != FRAME_FIXED_SIZE + numPads * FRAME_PAD_SIZE + FRAME_CRC_SIZE)
+    return false;
+
+  const uint8_t *crcCursor = buffer + length - FRAME_CRC_SIZE;
+  if (getU16(crcCursor) != crc16(buffer, length - FRAME_CRC_SIZE))
+    return false;
+
+  const uint8_t *cursor = buffer + 4;
+  snapshot.numPads = numPads;
+  snapshot.sequence = getU32(cursor);
+  snapshot.uptimeMs = getU32(cursor);
+  for (uint8_t i = 0; i < METRIC_COUNT; ++i) {
+    snapshot.counters[i] = getU32(cursor);
+  }
+  snapshot.scanIntervalMinUs = getU32(cursor);
+  snapshot.scanIntervalMaxUs = getU32(cursor);
+  snapshot.scanJitterUs = getU32(cursor);
+  snapshot.commonMode = static_cast<int16_t>(getU16(cursor));
+  snapshot.commonModePeak = getU16(cursor);
+  for (uint8_t i = 0; i < numPads; ++i) {
+    snapshot.pads[i].pad = *cursor++;
+    snapshot.pads[i].baseline = getU32(cursor);
+    snapshot.pads[i].filtered = getU32(cursor);
+    snapshot.pads[i].noise = getU16(cursor);
+  }
+  return true;
+}
+
+/**
+ * @brief Calculate the slider events per second between two frames.
+ *
+ * Events are swipes, swipe fines and button presses.
+ *
+ * @param previous The older frame.
+ * @param current The newer frame.
+ * @return Events per second, 0 if the frames have the same time.
+ */
+uint32_t TouchMetrics::eventsPerSecond(const TouchMetricsSnapshot &previous, const TouchMetricsSnapshot &current) {
+  static const TouchMetric events[] = {METRIC_SWIPE_UP, METRIC_SWIPE_DOWN, METRIC_SWIPE_FINE_UP, METRIC_SWIPE_FINE_DOWN, METRIC_BUTTON_PRESSES};
+
+  uint32_t elapsedMs = current.uptimeMs - previous.uptimeMs;
+  if (elapsedMs == 0)
+    return 0;
+
+  uint32_t numEvents = 0;
+  for (uint8_t i = 0; i < sizeof(events) / sizeof(events[0]); ++i) {
+    numEvents += current.counters[events[i]] - previous.counters[events[i]];
+  }
+  return static_cast<uint64_t>(numEvents) * 1000 / elapsedMs;
+}
+
+/**
+ * @brief Calculate the CRC16-CCITT (polynomial 0x1021, initial value 0xFFFF) of some data.
+ * @param data The data.
+ * @param length Length of the data.
+ * @return The CRC.
+ */
+uint16_t TouchMetrics::crc16(const uint8_t data[], size_t length) {
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < length; ++i) {
+    crc ^= static_cast<uint16_t>(data[i]) << 8;
+    for (uint8_t bit = 0; bit < 8; ++bit) {
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+  }
+  return crc;
+}
@@ -0,0 +1,120 @@
+/*
+* Marcos Abraham Carballo Vazquez
+* Original Creation Date: Dicember 5, 2024
+* https://github.com/MarcosCarballoV/TouchSlider_ESP32
+* */
+
+#ifndef TOUCHMETRICS_H
+#define TOUCHMETRICS_H
+
+/**
+* Metrics registry of the touch slider and its compact binary telemetry frame.
+*
+* TouchSlider updates the registry on every scan (event counters, scan jitter, per-pad baseline and noise, false-touch
+* indicators). encodeFrame() packs it in a little-endian frame protected by a CRC16, that can be streamed periodically
+* over any Stream. decodeFrame() has no dependency on the ESP32 and can be built on the host side of a monitoring agent.
+*
+* Frame layout (little-endian):
+*   0   'T' 'M'                       Magic
+*   2   uint8   version               METRICS_FRAME_VERSION
+*   3   uint8   numPads               Pads included in the frame
+*   4   uint32  sequence              Frame counter
+*   8   uint32  uptimeMs              Time of the frame
+*   12  uint32  counters[METRIC_COUNT]  Totals since start (see TouchMetric)
+*   ..  uint32  scanIntervalMinUs     Shortest scan interval since the previous frame
+*   ..  uint32  scanIntervalMaxUs     Longest scan interval since the previous frame
+*   ..  uint32  scanJitterUs          Mean absolute deviation from the nominal interval since the previous frame
+*   ..  int16   commonMode            Last common-mode compensation of the reference pad, 0.01 % of its baseline
+*   ..  uint16  commonModePeak        Largest absolute compensation since the previous frame, 0.01 %
+*   ..  numPads x {uint8 pad, uint32 baseline, uint32 filtered, uint16 noise (Q4)}
+*   ..  uint16  crc                   CRC16-CCITT (0x1021, init 0xFFFF) of all the previous bytes
+*/
+/*********************** EXTERNAL LIBRARIES **********************/
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*********************** LIBRARY OPTIONS **********************/
+#define METRICS_MAX_PADS          15          // Maximum number of pads tracked (touch pads of the ESP32-S2/S3)
+#define METRICS_FRAME_VERSION     1           // Version of the binary frame, changes with the layout
+#define METRICS_FRAME_MAX_SIZE    260         // Size of a frame with every pad included
+#define METRICS_NOISE_SHIFT       3           // Noise averaging, each reading weights 1/8
+
+/*********************** TYPES **********************/
+enum TouchMetric : uint8_t {
+  METRIC_SCANS = 0,               // Scans of the touch pads
+  METRIC_TOUCHES,                 // Touch episodes on the slider
+  METRIC_SWIPE_UP,                // Swipe up events
+  METRIC_SWIPE_DOWN,              // Swipe down events
+  METRIC_SWIPE_FINE_UP,           // Swipe fine up events
+  METRIC_SWIPE_FINE_DOWN,         // Swipe fine down events
+  METRIC_BUTTON_PRESSES,          // Touch button short presses
+  METRIC_DROPPED_EVENTS,          // Events lost before the application read them
+  METRIC_SHORT_TOUCHES,           // Touch episodes of a single scan (false-touch indicator)
+  METRIC_SPLIT_TOUCH_SCANS,       // Scans with untouched pads between touched pads (false-touch indicator)
+  METRIC_ALL_PADS_SCANS,          // Scans with every slider pad touched at once (common-mode false-touch indicator)
+  METRIC_DROPPED_FRAMES,          // Telemetry frames that could not be written
+  METRIC_PINCH,                   // Two-finger pinch steps
+  METRIC_SPREAD,                  // Two-finger spread steps
+  METRIC_TWO_FINGER_SWIPES,       // Two-finger swipe steps, up or down
+  METRIC_HOVERS,                  // Fingers approaching the slider without touching it
+  METRIC_COUNT
+};
+
+struct TouchMetricsPad {
+  uint8_t pad;                    // Touch pad number
+  uint32_t baseline;              // Untouched value
+  uint32_t filtered;              // Last filtered value
+  uint16_t noise;                 // Mean absolute change between untouched scans (Q4, 16 = 1 count)
+};
+
+struct TouchMetricsSnapshot {
+  uint32_t sequence;              // Frame counter
+  uint32_t uptimeMs;              // Time of the frame
+  uint32_t counters[METRIC_COUNT];  // Totals since start
+  uint32_t scanIntervalMinUs;     // Shortest scan interval of the window
+  uint32_t scanIntervalMaxUs;     // Longest scan interval of the window
+  uint32_t scanJitterUs;          // Mean absolute deviation from the nominal interval of the window
+  int16_t commonMode;             // Last common-mode compensation, 0.01 % of the reference baseline (positive towards touch)
+  uint16_t commonModePeak;        // Largest absolute compensation of the window, 0.01 %
+  uint8_t numPads;                // Pads in the snapshot
+  TouchMetricsPad pads[METRICS_MAX_PADS];   // Pad health
+};
+
+/*********************** CLASS DEFINITION **********************/
+
+class TouchMetrics
+{
+  public:
+    // Recording, called by TouchSlider
+    void increment(TouchMetric metric) {_counters[metric]++;};                          // Increment a counter
+    void recordScan(uint32_t intervalUs, uint32_t nominalUs);                           // Record the interval between two scans
+    void recordPad(uint8_t pad, uint32_t baseline, uint32_t filtered, bool touched);    // Record the state of a pad
+    void recordCommonMode(int16_t basisPoints);                                         // Record the common-mode compensation of a scan
+    void reset();                                                                       // Reset every metric
+
+    // Getters
+    uint32_t getCounter(TouchMetric metric) {return _counters[metric];};                // Get a counter
+
+    // Frames
+    size_t encodeFrame(uint8_t buffer[], size_t size, uint32_t uptimeMs);               // Encode a frame and start a new jitter window, returns its length or 0
+    static bool decodeFrame(const uint8_t buffer[], size_t length, TouchMetricsSnapshot &snapshot);   // Decode and check a frame
+    static uint32_t eventsPerSecond(const TouchMetricsSnapshot &previous, const TouchMetricsSnapshot &current);   // Slider events per second between two frames
+    static uint16_t crc16(const uint8_t data[], size_t length);                         // CRC16-CCITT of the frame
+
+  private:
+    uint32_t _counters[METRIC_COUNT] = {};                            // Totals since start
+    uint32_t _sequence = 0;                                           // Frame counter
+    uint32_t _scanIntervalMinUs = UINT32_MAX;                         // Shortest scan interval of the window
+    uint32_t _scanIntervalMaxUs = 0;                                  // Longest scan interval of the window
+    uint64_t _scanJitterSumUs = 0;                                    // Sum of the deviations of the window
+    uint32_t _scanWindowCount = 0;                                    // Scans of the window
+    int16_t _commonMode = 0;                                          // Last common-mode compensation (0.01 %)
+    uint16_t _commonModePeak = 0;                                     // Largest absolute compensation of the window (0.01 %)
+
+    uint16_t _padMask = 0;                                            // Pads recorded
+    uint32_t _padBaseline[METRICS_MAX_PADS];                          // Untouched value of each pad
+    uint32_t _padFiltered[METRICS_MAX_PADS];                          // Last filtered value of each pad
+    uint16_t _padNoise[METRICS_MAX_PADS];                             // Noise of each pad (Q4)
+};
+#endif
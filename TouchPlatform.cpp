@@ -0,0 +1,86 @@
+#include "TouchPlatform.h"
+
+#ifdef TOUCHSLIDER_HOST_DRIVER
+  #include <time.h>
+#endif
+
+/*********************** PLATFORM **********************/
+/**
+ * @brief Get the time since boot.
+ * @return The time in us (host: monotonic clock of the system).
+ */
+int64_t TouchPlatform::getTimeUs() {
+#ifdef TOUCHSLIDER_HOST_DRIVER
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return static_cast<int64_t>(now.tv_sec) * 1000000 + now.tv_nsec / 1000;
+#else
+  return esp_timer_get_time();
+#endif
+}
+
+/**
+ * @brief Block the calling task, other tasks keep running.
+ * @param ms Time to wait in ms (host: no wait).
+ */
+void TouchPlatform::delayMs(uint32_t ms) {
+#ifdef TOUCHSLIDER_HOST_DRIVER
+  (void)ms;
+#else
+  vTaskDelay(pdMS_TO_TICKS(ms) > 0 ? pdMS_TO_TICKS(ms) : 1);
+#endif
+}
+
+/*********************** TIMER **********************/
+/**
+ * @brief Destructor, deletes the esp_timer.
+ */
+TouchTimer::~TouchTimer() {
+  detach();
+#ifndef TOUCHSLIDER_HOST_DRIVER
+  if (_timer != nullptr)
+    esp_timer_delete(_timer);
+#endif
+}
+
+/**
+ * @brief Start calling a callback periodically, replacing the previous one.
+ *
+ * @param periodMs Period in ms.
+ * @param callback Function called on every period, from the esp_timer task.
+ * @param arg Argument of the callback.
+ */
+void TouchTimer::attach_ms(uint32_t periodMs, Callback callback, void *arg) {
+  detach();
+#ifdef TOUCHSLIDER_HOST_DRIVER
+  (void)periodMs;
+  (void)callback;
+  (void)arg;
+#else
+  if (_timer != nullptr) {    // The callback is fixed at creation
+    esp_timer_delete(_timer);
+    _timer = nullptr;
+  }
+  esp_timer_create_args_t timerArgs = {};
+  timerArgs.callback = callback;
+  timerArgs.arg = arg;
+  timerArgs.dispatch_method = ESP_TIMER_TASK;
+  timerArgs.name = "TouchSlider";
+  if (esp_timer_create(&timerArgs, &_timer) != ESP_OK)
+    return;
+  esp_timer_start_periodic(_timer, static_cast<uint64_t>(periodMs) * 1000ULL);
+#endif
+  _active = true;
+}
+
+/**
+ * @brief Stop calling the callback.
+ */
+void TouchTimer::detach() {
+  if (!_active)
+    return;
+#ifndef TOUCHSLIDER_HOST_DRIVER
+  esp_timer_stop(_timer);
+#endif
+  _active = false;
+}
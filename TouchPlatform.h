@@ -0,0 +1,63 @@
+/*
+* Marcos Abraham Carballo Vazquez
+* Original Creation Date: Dicember 5, 2024
+* https://github.com/MarcosCarballoV/TouchSlider_ESP32
+* */
+
+#ifndef TOUCHPLATFORM_H
+#define TOUCHPLATFORM_H
+
+/**
+* Thin layer over the ESP-IDF services used by the library: esp_timer for the scan timer and the time, FreeRTOS for
+* the delays and esp_log for the messages. The library does not need the Arduino core, which only adds an adapter
+* (TouchSliderArduino.cpp).
+*
+* With TOUCHSLIDER_HOST_DRIVER the same API runs on a host computer: the time comes from the system clock, the log goes
+* to stdout and the timer never fires, the scans are run with TouchSlider::simulateScan().
+*/
+/*********************** EXTERNAL LIBRARIES **********************/
+
+#include <stdint.h>
+
+#ifdef TOUCHSLIDER_HOST_DRIVER    // Build without ESP-IDF, see TouchDriverHost.h
+  #include <stdio.h>
+  #ifndef ESP_LOGE
+    #define ESP_LOGE(tag, format, ...)    printf("E (%s) " format "\n", tag, ##__VA_ARGS__)
+    #define ESP_LOGW(tag, format, ...)    printf("W (%s) " format "\n", tag, ##__VA_ARGS__)
+    #define ESP_LOGI(tag, format, ...)    printf("I (%s) " format "\n", tag, ##__VA_ARGS__)
+    #define ESP_LOGD(tag, format, ...)    do {} while (0)
+    #define ESP_LOGV(tag, format, ...)    do {} while (0)
+  #endif
+#else
+  #include <esp_timer.h>
+  #include <esp_log.h>
+  #include <freertos/FreeRTOS.h>
+  #include <freertos/task.h>
+#endif
+
+/*********************** CLASS DEFINITION **********************/
+
+class TouchPlatform
+{
+  public:
+    static int64_t getTimeUs();                                                     // Get the time since boot in us
+    static void delayMs(uint32_t ms);                                               // Block the calling task for some ms
+};
+
+class TouchTimer
+{
+  public:
+    typedef void (*Callback)(void *arg);                                            // Called on every period, from the esp_timer task
+
+    ~TouchTimer();
+    void attach_ms(uint32_t periodMs, Callback callback, void *arg);                // Start calling the callback periodically
+    void detach();                                                                  // Stop calling the callback
+    bool active() {return _active;};                                                // Check if the timer is running
+
+  private:
+#ifndef TOUCHSLIDER_HOST_DRIVER
+    esp_timer_handle_t _timer = nullptr;                              // esp_timer of the period
+#endif
+    bool _active = false;                                             // Indicates whether the timer is running
+};
+#endif
@@ -0,0 +1,137 @@
+#include "TouchSegmentDecoder.h"
+
+/*********************** PUBLIC FUNCTIONS **********************/
+/**
+ * @brief Set the channel of every segment.
+ *
+ * @param segmentChannels Channel (slider pad index) of every segment, from the bottom segment to the top one. Declare
+ *                        it as a constant so it stays in flash.
+ * @param numSegments Number of segments, up to SEGMENT_MAX.
+ * @param numChannels Number of channels, up to SEGMENT_MAX_CHANNELS.
+ * @return true if the layout is valid, false if a channel is out of range or two adjacent segments share a channel
+ *         (the decoder is left without a layout).
+ */
+bool TouchSegmentDecoder::setLayout(const uint8_t segmentChannels[], uint8_t numSegments, uint8_t numChannels) {
+  _segmentChannels = nullptr;
+  _numSegments = 0;
+  _numChannels = 0;
+  _touched = false;
+  if (numSegments == 0 || numSegments > SEGMENT_MAX || numChannels == 0 || numChannels > SEGMENT_MAX_CHANNELS)
+    return false;
+
+  for (uint8_t i = 0; i < numSegments; ++i) {
+    if (segmentChannels[i] >= numChannels)
+      return false;
+    if (i > 0 && segmentChannels[i] == segmentChannels[i - 1])
+      return false;   // The boundary could not be told from the segment
+  }
+
+  _segmentChannels = segmentChannels;
+  _numSegments = numSegments;
+  _numChannels = numChannels;
+  return true;
+}
+
+/**
+ * @brief Resolve the touched segments from the channels of a scan.
+ *
+ * The strongest touched channel and the strongest other channel are taken, the second one only needs to reach
+ * SEGMENT_PAIR_PERCENT of the first, since a finger between two segments rarely pushes both over the threshold. If they
+ * are used by two adjacent segments, the finger is on their boundary, otherwise only the strongest channel is used.
+ *
+ * @param deltas Signal of each channel in the touch direction.
+ * @param touched Touch state of each channel.
+ * @return true if a segment is touched and resolved.
+ */
+bool TouchSegmentDecoder::decode(const uint32_t deltas[], const bool touched[]) {
+  int8_t strongest = -1;
+  for (uint8_t c = 0; c < _numChannels; ++c) {
+    if (touched[c] && (strongest < 0 || deltas[c] > deltas[strongest]))
+      strongest = c;
+  }
+  if (strongest < 0) {
+    _touched = false;
+    return false;
+  }
+
+  int8_t second = -1;
+  for (uint8_t c = 0; c < _numChannels; ++c) {
+    if (c != strongest && (second < 0 || deltas[c] > deltas[second]))
+      second = c;
+  }
+  if (second >= 0 && static_cast<uint64_t>(deltas[second]) * 100 < static_cast<uint64_t>(deltas[strongest]) * SEGMENT_PAIR_PERCENT)
+    second = -1;
+
+  bool resolved = second >= 0 && resolvePair(strongest, second, deltas);
+  if (!resolved)
+    resolved = resolveSingle(strongest);
+  if (!resolved && _ambiguousScans < UINT32_MAX)
+    _ambiguousScans++;
+  _touched = resolved;
+  return resolved;
+}
+
+/*********************** PRIVATE FUNCTIONS **********************/
+/**
+ * @brief Resolve a touch on two channels.
+ *
+ * @param channelA The strongest channel.
+ * @param channelB The second channel.
+ * @param deltas Signal of each channel, a much weaker second channel only touches the edge of its segment.
+ * @return true if the pair is a boundary of the layout and it could be resolved.
+ */
+bool TouchSegmentDecoder::resolvePair(uint8_t channelA, uint8_t channelB, const uint32_t deltas[]) {
+  int16_t best = -1;    // Segment below the boundary
+  uint8_t bestDistance = UINT8_MAX;
+  uint8_t candidates = 0;
+  for (uint8_t k = 0; k + 1 < _numSegments; ++k) {
+    uint8_t low = _segmentChannels[k];
+    uint8_t high = _segmentChannels[k + 1];
+    if (!((low == channelA && high == channelB) || (low == channelB && high == channelA)))
+      continue;
+
+    ++candidates;
+    uint8_t d = _touched ? distance(2 * k + 1, getPosition()) : 0;
+    if (best < 0 || d < bestDistance) {
+      best = k;
+      bestDistance = d;
+    }
+  }
+  if (best < 0 || (candidates > 1 && !_touched))
+    return false;
+
+  bool both = static_cast<uint64_t>(deltas[channelB]) * 100 >= static_cast<uint64_t>(deltas[channelA]) * SEGMENT_SHARE_PERCENT;
+  uint8_t strongSegment = _segmentChannels[best] == channelA ? best : best + 1;
+  _firstSegment = both ? best : strongSegment;
+  _lastSegment = both ? best + 1 : strongSegment;
+  return true;
+}
+
+/**
+ * @brief Resolve a touch on one channel.
+ *
+ * @param channel The touched channel.
+ * @return true if the channel is used by a single segment, or by several and the previous position picks one.
+ */
+bool TouchSegmentDecoder::resolveSingle(uint8_t channel) {
+  int16_t best = -1;
+  uint8_t bestDistance = UINT8_MAX;
+  uint8_t candidates = 0;
+  for (uint8_t s = 0; s < _numSegments; ++s) {
+    if (_segmentChannels[s] != channel)
+      continue;
+
+    ++candidates;
+    uint8_t d = _touched ? distance(2 * s, getPosition()) : 0;
+    if (best < 0 || d < bestDistance) {
+      best = s;
+      bestDistance = d;
+    }
+  }
+  if (best < 0 || (candidates > 1 && !_touched))
+    return false;
+
+  _firstSegment = best;
+  _lastSegment = best;
+  return true;
+}
@@ -0,0 +1,71 @@
+/*
+* Marcos Abraham Carballo Vazquez
+* Original Creation Date: Dicember 5, 2024
+* https://github.com/MarcosCarballoV/TouchSlider_ESP32
+* */
+
+#ifndef TOUCHSEGMENTDECODER_H
+#define TOUCHSEGMENTDECODER_H
+
+/**
+* Decoder for interleaved (duplexed) sliders, where several physical segments share one touch channel.
+*
+* The layout lists the channel (slider pad index) of every segment, from the bottom segment to the top one. Adjacent
+* segments must use different channels, and a finger on the slider usually covers two adjacent segments, so the pair
+* formed by the touched channel and the strongest other channel (SEGMENT_PAIR_PERCENT) tells where it is:
+*   - A pair used by a single boundary of the layout is resolved directly, even on the first scan of a touch.
+*   - A pair used by several boundaries, or a single channel, is resolved with the position of the previous scan: the
+*     nearest candidate is taken.
+* Touches that start on an ambiguous pair or on a single channel are not reported until they are resolved.
+*
+* With every pair used once, N channels give up to N * (N - 1) / 2 + 1 segments, for example 11 segments (21 half
+* segment positions) on 5 channels:
+*   const uint8_t layout[] = {0, 1, 2, 3, 4, 0, 2, 4, 1, 3, 0};
+* Repeating patterns ({0, 1, 2, 0, 1, 2, ...}) give more segments, but a touch must start on a segment it can resolve.
+*/
+/*********************** EXTERNAL LIBRARIES **********************/
+
+#include <stdint.h>
+
+/*********************** LIBRARY OPTIONS **********************/
+#define SEGMENT_MAX               32          // Maximum number of segments of the layout
+#define SEGMENT_MAX_CHANNELS      16          // Maximum number of channels of the layout
+#define SEGMENT_PAIR_PERCENT      25          // A second channel reaching this percentage of the touched one is part of the pair, even below its threshold
+#define SEGMENT_SHARE_PERCENT     50          // The weaker channel of a pair must reach this percentage of the stronger one to touch both segments
+
+/*********************** CLASS DEFINITION **********************/
+
+class TouchSegmentDecoder
+{
+  public:
+    // Configuration
+    bool setLayout(const uint8_t segmentChannels[], uint8_t numSegments, uint8_t numChannels);   // Set the channel of every segment, the table is not copied and must outlive the decoder
+
+    // Input, called by TouchSlider
+    bool decode(const uint32_t deltas[], const bool touched[]);                  // Resolve the touched segments from the channels of a scan
+    void reset() {_touched = false;};                                            // Forget the position of the previous scan
+
+    // Getters
+    bool isTouched() {return _touched;};                                         // Check if a segment is touched (resolved)
+    uint8_t getFirstSegment() {return _firstSegment;};                           // Get the first touched segment
+    uint8_t getLastSegment() {return _lastSegment;};                             // Get the last touched segment, the same or the next one
+    uint8_t getPosition() {return _firstSegment + _lastSegment;};                // Get the position in half segments, 0 is the bottom segment
+    uint8_t getNumSegments() {return _numSegments;};                             // Get the number of segments, 0 without a valid layout
+    uint8_t getNumChannels() {return _numChannels;};                             // Get the number of channels of the layout
+    uint32_t getAmbiguousScans() {return _ambiguousScans;};                      // Get the touched scans that could not be resolved
+
+  private:
+    const uint8_t* _segmentChannels = nullptr;                        // Channel of every segment
+    uint8_t _numSegments = 0;                                         // Number of segments
+    uint8_t _numChannels = 0;                                         // Number of channels
+
+    bool _touched = false;                                            // Indicates whether the last scan was resolved
+    uint8_t _firstSegment = 0;                                        // First touched segment
+    uint8_t _lastSegment = 0;                                         // Last touched segment
+    uint32_t _ambiguousScans = 0;                                     // Touched scans that could not be resolved
+
+    bool resolvePair(uint8_t channelA, uint8_t channelB, const uint32_t deltas[]);   // Resolve a touch on two channels
+    bool resolveSingle(uint8_t channel);                                             // Resolve a touch on one channel
+    static uint8_t distance(uint8_t a, uint8_t b) {return a > b ? a - b : b - a;};   // Distance between two positions
+};
+#endif
@@ -4,10 +4,38 @@
 // Static members must be initialized here
 bool TouchSlider::_padEnabled[TOUCH_PAD_MAX];               // Array to store the enabled status of each touch pad
 uint8_t TouchSlider::_padThresholdPercent[TOUCH_PAD_MAX];   // Array to store the threshold percentage for each touch pad
-uint16_t TouchSlider::_padFilteredValue[TOUCH_PAD_MAX];     // Array to store the filtered value of each touch pad
-uint16_t TouchSlider::_padThreshold[TOUCH_PAD_MAX];         // Array to store the threshold value for each touch pad
+uint32_t TouchSlider::_padFilteredValue[TOUCH_PAD_MAX];     // Array to store the filtered value of each touch pad
+uint32_t TouchSlider::_padBaseline[TOUCH_PAD_MAX];          // Array to store the baseline (untouched value) of each touch pad
+uint32_t TouchSlider::_padThreshold[TOUCH_PAD_MAX];         // Array to store the threshold value for each touch pad, as a change from the baseline
+uint32_t TouchSlider::_padProximityThreshold[TOUCH_PAD_MAX];  // Array to store the proximity threshold for each touch pad, as a change from the baseline
+uint32_t TouchSlider::_padDelta[TOUCH_PAD_MAX];             // Array to store the compensated signal of each touch pad
 int8_t TouchSlider::_sliderValue[TOUCH_PAD_MAX];           // Array to store the slider value for each touch pad, pad touch is set to 0, pad left is set to -1, pad right is set to 1
 
+/*********************** LOCAL TYPES **********************/
+// Readings of the enabled touch pads for the auto-tuner
+class TouchSliderTuneSensor : public TouchTuneSensor
+{
+  public:
+    touch_pad_t pads[TUNE_MAX_PADS];                                  // Touch pad of each tuned pad
+    uint8_t thresholdPercent[TUNE_MAX_PADS];                          // Threshold percentage of each tuned pad
+    uint8_t numPads = 0;                                              // Number of tuned pads
+
+    void apply(const TouchTuneSetting &setting) override {
+      TouchDriver::setVoltage(setting.voltage);
+      TouchDriver::setMeasurementCycles(setting.measCycles);
+      TouchPlatform::delayMs(TUNE_SETTLE_MS);
+    }
+
+    uint32_t read(uint8_t pad) override {
+      if (pad == 0)   // The tuner reads every pad once per sample, wait for a new measurement
+        TouchPlatform::delayMs(TUNE_SAMPLE_INTERVAL_MS);
+      return TouchDriver::readRaw(pads[pad]);
+    }
+
+    uint8_t getNumPads() override {return numPads;};
+    uint8_t getThresholdPercent(uint8_t pad) override {return thresholdPercent[pad];};
+};
+
 /*********************** CONSTRUCTORS **********************/
 /**
  * @brief Constructor for TouchSlider class
@@ -18,7 +46,7 @@ int8_t TouchSlider::_sliderValue[TOUCH_PAD_MAX];           // Array to store the
  * @param threshold The threshold value to determine touch sensitivity. Values above this threshold indicate touch.
  * @param numSliderPins The number of slider electrodes/pins.
  **/
-TouchSlider::TouchSlider(gpio_num_t sliderPins[], uint8_t threshold, uint8_t numSliderPins) {
+TouchSlider::TouchSlider(const gpio_num_t sliderPins[], uint8_t threshold, uint8_t numSliderPins) {
   _numSliderPins = numSliderPins;  
   
   if (_numSliderPins > 10)      // Limit the number of slider pins to 10 to prevent array overflow
@@ -26,9 +54,9 @@ TouchSlider::TouchSlider(gpio_num_t sliderPins[], uint8_t threshold, uint8_t num
 
   for (uint8_t i = 0; i < _numSliderPins; ++i) {   // Initialize arrays to store slider pins and corresponding touch pads
     _arraySliderPins[i] = sliderPins[i];
-    _arraySliderPads[i] = mapGpioToTouchPad(sliderPins[i]);
+    _arraySliderPads[i] = TouchDriver::mapGpioToTouchPad(sliderPins[i]);
     if(_arraySliderPads[i] == TOUCH_PAD_MAX) {
-      Serial.printf("Error: GPIO pin %d is not a valid touch pad.\n", sliderPins[i]);
+      log_e("GPIO pin %d is not a valid touch pad.", sliderPins[i]);
       return;
     }
   }
@@ -36,12 +64,7 @@ TouchSlider::TouchSlider(gpio_num_t sliderPins[], uint8_t threshold, uint8_t num
   TOUCH_THRESHOLD = threshold;
   TOUCH_BUTTON_MAX = TOUCH_PAD_MAX - _numSliderPins;
 
-  touch_pad_init();                                 // Initialize touch pad peripheral
-  touch_pad_set_fsm_mode(TOUCH_FSM_MODE_TIMER);     // If use interrupt trigger mode, should set TOUCH_FSM_MODE_TIMER
-                                                    // Set reference voltage for charging/discharging
-                                                    // For most usage scenarios, we recommend using the following combination:
-                                                    // the high reference valtage will be 2.7V - 1V = 1.7V, The low reference voltage will be 0.5V.
-  touch_pad_set_voltage(TOUCH_HVOLT_2V7, TOUCH_LVOLT_0V5, TOUCH_HVOLT_ATTEN_1V5);
+  TouchDriver::init();                              // Initialize touch pad peripheral (FSM mode, reference voltages, v2 denoise and filter)
 
   setDefaultConfiguration();
 }
@@ -55,7 +78,7 @@ TouchSlider::TouchSlider(gpio_num_t sliderPins[], uint8_t threshold, uint8_t num
  * @param threshold The threshold value to determine touch sensitivity. Values above this threshold indicate touch.
  * @param numSliderPins The number of slider electrodes/pins.
  **/
-TouchSlider::TouchSlider(gpio_num_t sliderPins[], uint8_t threshold[], uint8_t numSliderPins) {
+TouchSlider::TouchSlider(const gpio_num_t sliderPins[], uint8_t threshold[], uint8_t numSliderPins) {
   _numSliderPins = numSliderPins;
   
   if (_numSliderPins > 10)      // Limit the number of slider pins to 10 to prevent array overflow
@@ -63,9 +86,9 @@ TouchSlider::TouchSlider(gpio_num_t sliderPins[], uint8_t threshold[], uint8_t n
 
   for (uint8_t i = 0; i < _numSliderPins; ++i) {    // Initialize arrays to store slider pins and corresponding touch pads
     _arraySliderPins[i] = sliderPins[i];
-    _arraySliderPads[i] = mapGpioToTouchPad(sliderPins[i]);
+    _arraySliderPads[i] = TouchDriver::mapGpioToTouchPad(sliderPins[i]);
     if(_arraySliderPads[i] == TOUCH_PAD_MAX) {
-      Serial.printf("Error: GPIO pin %d is not a valid touch pad.\n", sliderPins[i]);
+      log_e("GPIO pin %d is not a valid touch pad.", sliderPins[i]);
       return;
     }
     TOUCH_THRESHOLD_ARRAY[i] = threshold[i];
@@ -73,13 +96,7 @@ TouchSlider::TouchSlider(gpio_num_t sliderPins[], uint8_t threshold[], uint8_t n
 
   TOUCH_BUTTON_MAX = TOUCH_PAD_MAX - _numSliderPins;
 
-  touch_pad_init();                                 // Initialize touch pad peripheral
-  touch_pad_set_fsm_mode(TOUCH_FSM_MODE_TIMER);     // If use interrupt trigger mode, should set TOUCH_FSM_MODE_TIMER
-                                                    // Set reference voltage for charging/discharging
-                                                    // For most usage scenarios, we recommend using the following combination:
-                                                    // the high reference valtage will be 2.7V - 1V = 1.7V, The low reference voltage will be 0.5V.
-                                                    
-  touch_pad_set_voltage(TOUCH_HVOLT_2V7, TOUCH_LVOLT_0V5, TOUCH_HVOLT_ATTEN_1V5);
+  TouchDriver::init();                              // Initialize touch pad peripheral (FSM mode, reference voltages, v2 denoise and filter)
 
   setDefaultConfiguration();
 }
@@ -101,26 +118,31 @@ void TouchSlider::addTouchButton(gpio_num_t buttonPin, uint8_t thresholdPercent)
 
   for (uint8_t i = 0; i < _numTouchButtons; ++i) {    // Check if the button is already in the list of touch buttons
     if (_arrayButtonPins[i] == buttonPin) {
-      Serial.printf("Button %d is already in the list of touch buttons.\n", buttonPin);
+      log_w("Button %d is already in the list of touch buttons.", buttonPin);
       return; // The button is already in the list of buttons, exit the function
     }
   }
 
   for (uint8_t i = 0; i < _numSliderPins; ++i) {      // Check if the button is already in the list of sliders
     if (_arraySliderPins[i] == buttonPin) {
-      Serial.printf("Button %d is already in the list of sliders.\n", buttonPin);
+      log_w("Button %d is already in the list of sliders.", buttonPin);
       return; // The button is already in the list of sliders, exit the function
     }
   }
+
+  if (buttonPin == _referencePin) {                   // The reference pad must stay untouched
+    log_w("Button %d is the reference pad.", buttonPin);
+    return;
+  }
   
   _arrayButtonPins[_numTouchButtons] = buttonPin;     // Add the touch button
-  _arrayButtonPads[_numTouchButtons] = mapGpioToTouchPad(buttonPin);
+  _arrayButtonPads[_numTouchButtons] = TouchDriver::mapGpioToTouchPad(buttonPin);
   if(_arrayButtonPads[_numTouchButtons] == TOUCH_PAD_MAX) {
-    Serial.printf("Error: GPIO pin %d is not a valid touch pad.\n", buttonPin);
+    log_e("GPIO pin %d is not a valid touch pad.", buttonPin);
     return;
   }
 
-  Serial.printf("Added Button %d successfully with TouchPin %d.", _numTouchButtons + 1, mapGpioToTouchPad(buttonPin));
+  log_i("Added Button %d successfully with TouchPin %d.", _numTouchButtons + 1, TouchDriver::mapGpioToTouchPad(buttonPin));
   enableTouchButtons();
   _buttonThresholdPercent[_numTouchButtons] = thresholdPercent;
   _numTouchButtons++;
@@ -136,7 +158,7 @@ void TouchSlider::addTouchButton(gpio_num_t buttonPin, uint8_t thresholdPercent)
 void TouchSlider::removeTouchButton(gpio_num_t buttonPin)
 {
   if(_numTouchButtons == 0) {
-    Serial.println("No touch buttons to remove.");
+    log_w("No touch buttons to remove.");
     return;
   }
 
@@ -147,12 +169,12 @@ void TouchSlider::removeTouchButton(gpio_num_t buttonPin)
         _arrayButtonPads[j] = _arrayButtonPads[j + 1];
         _buttonThresholdPercent[j] = _buttonThresholdPercent[j + 1];
       }
-      Serial.printf("Removing Button %d from the list of touch buttons.\n", buttonPin);
+      log_i("Removing Button %d from the list of touch buttons.", buttonPin);
       return;
     }
   }
 
-  Serial.printf("Button %d is not in the list of touch buttons.\n", buttonPin);
+  log_w("Button %d is not in the list of touch buttons.", buttonPin);
 }
 
 
@@ -174,6 +196,9 @@ void TouchSlider::start() {
     setInput(_arrayButtonPads[i], _buttonThresholdPercent[i]);  // Set the touch threshold for buttons
   }
 
+  if (_referencePad != TOUCH_PAD_MAX)
+    setInput(_referencePad, 0);   // Scanned and calibrated with the other pads, but never touched
+
   begin();  // Begin the touch slider operation
 }
 
@@ -184,7 +209,7 @@ void TouchSlider::start() {
  */
 void TouchSlider::stop() {
   if (_sliderRunning) {
-    touch_pad_filter_stop();
+    TouchDriver::stop();
     sliderTicker.detach();  // Stop the timer if it is running
     _sliderRunning = false;  // Mark that the timer is not running
   }
@@ -197,28 +222,129 @@ void TouchSlider::stop() {
  */
 void TouchSlider::resume() {
   if (!_sliderRunning) {
-    touch_pad_filter_start(filter_period);
-    sliderTicker.attach_ms(UPDATE_INTERVAL, update, this);  // Restart the timer if it is not running
+    _simulating = false;
+    TouchDriver::start(filter_period, filter_read_cb);
+    sliderTicker.attach_ms(UPDATE_INTERVAL, timerCallback, this);  // Restart the timer if it is not running
     _sliderRunning = true;  // Mark that the timer is running
   }
 }
 
+/**
+ * @brief Set the interval to scan the touch pads.
+ *
+ * Shorter intervals catch faster swipes. The period of the metrics stream is kept in scans, enable it again to keep it in ms.
+ *
+ * @param intervalMs Scan interval in ms.
+ */
+void TouchSlider::setUpdateInterval(uint16_t intervalMs) {
+  if (intervalMs == 0)
+    return;
+  UPDATE_INTERVAL = intervalMs;
+  if (_sliderRunning) {
+    sliderTicker.detach();
+    sliderTicker.attach_ms(UPDATE_INTERVAL, timerCallback, this);  // Restart the timer with the new interval
+  }
+}
+
+/**
+ * @brief Start a simulation of the slider.
+ *
+ * The slider is stopped and its pads are enabled with their thresholds calculated from the given baselines. Every call
+ * to simulateScan() then runs the same scan as the timer, with injected values, so the engine can be benchmarked with
+ * a synthetic finger (see tests/TouchFingerModel.h) at any scan interval. The time of a scan is UPDATE_INTERVAL.
+ *
+ * @param baseline Untouched value of each slider pad, in the order of the slider pins.
+ * @param referenceBaseline Untouched value of the reference pad, if there is one (0 disables the compensation).
+ */
+void TouchSlider::beginSimulation(const uint32_t baseline[], uint32_t referenceBaseline) {
+  stop();
+  _simulating = true;
+  for (uint8_t i = 0; i < _numSliderPins; ++i) {
+    touch_pad_t pad = _arraySliderPads[i];
+    setInput(pad, TOUCH_THRESHOLD != 0 ? TOUCH_THRESHOLD : TOUCH_THRESHOLD_ARRAY[i]);
+    _padBaseline[pad] = baseline[i];
+    _padFilteredValue[pad] = baseline[i];
+    _padThreshold[pad] = TouchDriver::thresholdFromBaseline(baseline[i], _padThresholdPercent[pad]);
+  }
+  if (_referencePad != TOUCH_PAD_MAX) {
+    setInput(_referencePad, 0);
+    _padBaseline[_referencePad] = referenceBaseline;
+    _padFilteredValue[_referencePad] = referenceBaseline;
+    _padThreshold[_referencePad] = referenceBaseline;
+  }
+  calculateProximityThresholds();
+  _lastScanTimeUs = 0;
+}
+
+/**
+ * @brief Run one scan of a simulation with injected values.
+ * @param filtered Filtered value of each slider pad, in the order of the slider pins.
+ * @param referenceFiltered Filtered value of the reference pad, if there is one.
+ */
+void TouchSlider::simulateScan(const uint32_t filtered[], uint32_t referenceFiltered) {
+  if (!_simulating)
+    return;
+  for (uint8_t i = 0; i < _numSliderPins; ++i) {
+    _padFilteredValue[_arraySliderPads[i]] = filtered[i];
+  }
+  if (_referencePad != TOUCH_PAD_MAX)
+    _padFilteredValue[_referencePad] = referenceFiltered;
+  update(this);
+}
 
 /**
  * @brief Calibrate the touch pads thresholds.
  *
- * This function calibrates the touch pad thresholds by reading the filtered touch values and calculating the thresholds based on a specified percentage.
+ * This function calibrates the touch pad thresholds by reading the baseline of each pad and calculating the thresholds based on a specified percentage.
+ * Each pad is calibrated once its first measurement is done (up to BASELINE_TIMEOUT_MS after starting the measurement).
+ * On ESP32-S2/S3 the thresholds are also programmed on the peripheral, which keeps tracking the baseline afterwards.
  * It logs the calibrated thresholds for each enabled touch pad.
  */
 void TouchSlider::calibrate_thresholds() {
-  uint16_t touch_value;
   for (uint8_t i = 0; i < TOUCH_PAD_MAX; ++i) {
     if (_padEnabled[i]) {   
-      touch_pad_read_filtered(static_cast<touch_pad_t>(i), &touch_value);   // Read the filtered touch value for the touch pad (i)
-      _padThreshold[i] = static_cast<uint32_t>(touch_value) * _padThresholdPercent[i] / 100;  // Calculate and store the threshold based on a percentage of the touch value
-      log_i("T%u: %u - Threshold: %u", i, touch_value, _padThreshold[i]);   // Log the calibrated threshold for reference
+      touch_pad_t pad = static_cast<touch_pad_t>(i);
+      if (!TouchDriver::waitBaseline(pad, BASELINE_TIMEOUT_MS))   // v2: the benchmark is 0 until the first measurement
+        log_w("T%u: no measurement after %u ms, calibrate it again.", i, BASELINE_TIMEOUT_MS);
+      _padBaseline[i] = TouchDriver::readBaseline(pad);     // Read the untouched value for the touch pad (i)
+      _padFilteredValue[i] = TouchDriver::readFiltered(pad);
+      _padThreshold[i] = TouchDriver::thresholdFromBaseline(_padBaseline[i], _padThresholdPercent[i]);  // Calculate and store the threshold based on a percentage of the baseline
+      TouchDriver::setPadThreshold(pad, _padThreshold[i]);  // Program the per-channel threshold (v2)
+      log_i("T%u: %u - Threshold: %u", i, static_cast<unsigned>(_padBaseline[i]), static_cast<unsigned>(_padThreshold[i]));   // Log the calibrated threshold for reference
     }
   }
+  calculateProximityThresholds();
+}
+
+/**
+ * @brief Enable the proximity tier of the slider.
+ *
+ * The filtered values start moving before a finger touches the pads. When any slider pad passes the proximity threshold
+ * the slider is near: the proximity callback is called and, if no pad is touched yet, a hover is reported. The
+ * application can start waking up displays or amplifiers before the first swipe.
+ *
+ * @param thresholdPercent (0-100) Higher than the touch threshold of the slider pads, 0 disables the proximity tier.
+ */
+void TouchSlider::setProximityThreshold(uint8_t thresholdPercent) {
+  _proximityPercent = thresholdPercent > 100 ? 100 : thresholdPercent;
+  calculateProximityThresholds();
+  if (_proximityPercent == 0) {
+    _sliderNear = false;
+    _hoverDetected = false;
+  }
+}
+
+/**
+ * @brief Get the hover status of the TouchSlider.
+ *
+ * It resets the hover status after retrieving it.
+ *
+ * @retval true: A finger approached the slider without touching it since the last call
+ */
+bool TouchSlider::getHoverStatus() {
+  bool hover = _hoverDetected;
+  _hoverDetected = false;
+  return hover;
 }
 
 /**
@@ -254,7 +380,7 @@ int8_t TouchSlider::getSwipeStatus() {
  */
 int8_t TouchSlider::getSwipeStatusFine() {
   if(!_enableSwipeFine) {
-    Serial.println("Swipe Fine is disable, to active this function use enableSwipeFine()");   // Debugging
+    log_w("Swipe Fine is disable, to active this function use enableSwipeFine()");   // Debugging
     return 0;
   } else {
     int8_t swipeFineStatus = _swipeFineDownCount - _swipeFineUpCount;   // Calculate the swipe status as the difference between swipe-down and swipe-up counts
@@ -267,6 +393,63 @@ int8_t TouchSlider::getSwipeStatusFine() {
   }
 }
 
+/**
+ * @brief Get the pinch/spread status of the TouchSlider.
+ *
+ * This function returns the difference between the spread and pinch steps made with two fingers, and resets the counts.
+ *
+ * @return An int8_t value representing the pinch status.
+ *   - Positive values indicate spread gestures (the fingers move apart).
+ *   - Negative values indicate pinch gestures (the fingers move closer).
+ *   - 0 indicates no pinch.
+ */
+int8_t TouchSlider::getPinchStatus() {
+  int8_t pinchStatus = _spreadCount - _pinchCount;
+
+  // Reset the counts after retrieving the pinch status
+  _pinchCount = 0;
+  _spreadCount = 0;
+  return pinchStatus;
+}
+
+/**
+ * @brief Get the two-finger swipe status of the TouchSlider.
+ *
+ * This function returns the difference between the two-finger swipe-down and swipe-up steps, and resets the counts.
+ *
+ * @return An int8_t value representing the two-finger swipe status.
+ *   - Positive values indicate two-finger swipe-down gestures.
+ *   - Negative values indicate two-finger swipe-up gestures.
+ *   - 0 indicates no two-finger swipe.
+ */
+int8_t TouchSlider::getTwoFingerSwipeStatus() {
+  int8_t swipeStatus = _twoFingerSwipeDownCount - _twoFingerSwipeUpCount;
+
+  // Reset the counts after retrieving the swipe status
+  _twoFingerSwipeUpCount = 0;
+  _twoFingerSwipeDownCount = 0;
+  return swipeStatus;
+}
+
+/**
+ * @brief Get the contacts (fingers) found on the last scan.
+ *
+ * Each contact is a run of contiguous touched pads, up to two contacts are tracked. The position of each contact is
+ * reported separately, in half pads from the bottom pad, so a contact on two pads lies between them.
+ *
+ * @param contacts The array to store the contacts, sorted from bottom to top.
+ * @param maxContacts The size of the array.
+ * @return The number of contacts stored.
+ */
+uint8_t TouchSlider::getContacts(SliderContact contacts[], uint8_t maxContacts)
+{
+  uint8_t numContacts = _numContacts < maxContacts ? _numContacts : maxContacts;
+  for (uint8_t i = 0; i < numContacts; ++i) {
+    contacts[i] = _contacts[i];
+  }
+  return numContacts;
+}
+
 /**
  * @brief Get the index of the button that was short-pressed and reset the flag.
  *
@@ -276,7 +459,7 @@ int8_t TouchSlider::getSwipeStatusFine() {
  */
 gpio_num_t TouchSlider::getButtonShortPress() {
   if(!_enableTouchButtons) {
-    Serial.println("Touch Buttons is disable, to active this function use enableTouchButtons()");   // Debugging
+    log_w("Touch Buttons is disable, to active this function use enableTouchButtons()");   // Debugging
     return GPIO_NUM_NC;
   }
   gpio_num_t gpioButtonTouched = _gpioButtonTouched;    // Temporary variable to store the button that was short-pressed
@@ -323,6 +506,287 @@ void TouchSlider::getSliderTouched(bool sliderTouched[], uint8_t numSliderPins)
 }
 
 
+/**
+ * @brief Write a binary metrics frame with a writer periodically.
+ *
+ * The frame is prepared by the slider timer and written by flushMetrics(), called from the application task, so a slow
+ * writer never delays the scans. See TouchMetrics.h for its layout and TouchMetrics::decodeFrame() to decode it.
+ * The writer can send the frame to an UART, a socket or a file, enableMetricsStream() uses an Arduino Stream.
+ *
+ * @param writer Function that writes the frame, returns the bytes written.
+ * @param context Argument passed to the writer.
+ * @param periodMs Time between two frames in ms, rounded to the scan interval.
+ */
+void TouchSlider::enableMetricsWriter(MetricsWriter writer, void *context, uint16_t periodMs)
+{
+  _metricsPeriodScans = periodMs / UPDATE_INTERVAL;
+  if (_metricsPeriodScans == 0)
+    _metricsPeriodScans = 1;
+  _scansSinceFrame = 0;
+  _metricsFrameState = METRICS_FRAME_EMPTY;   // A pending frame was prepared for the previous writer
+  _metricsContext = context;
+  _metricsWriter = writer;
+}
+
+/**
+ * @brief Write the metrics frame prepared by the slider timer.
+ *
+ * Call it from the application task (for example from loop()) at least once per metrics period. Only the state of the
+ * frame is written here, a frame that can not be written completely is counted as dropped by the next scan that
+ * prepares a frame.
+ *
+ * @retval true: A frame was written
+ */
+bool TouchSlider::flushMetrics()
+{
+  if (_metricsWriter == nullptr || _metricsFrameState != METRICS_FRAME_READY)
+    return false;
+
+  bool written = _metricsWriter(_metricsFrame, _metricsFrameLength, _metricsContext) == _metricsFrameLength;
+  _metricsFrameState = written ? METRICS_FRAME_EMPTY : METRICS_FRAME_FAILED;
+  return written;
+}
+
+
+/**
+ * @brief Find the shortest measurement that meets a target SNR on every pad.
+ *
+ * Every reference voltage range is swept with the measurement cycles of the backend (see TouchAutoTuner). The pads must
+ * not be touched while tuning. The slider updates are paused, the profile found is applied and the thresholds are
+ * calibrated again. The profile can be saved (for example with Preferences) and restored with setTuneProfile().
+ *
+ * @param targetSnr Lowest ratio between the threshold delta and the noise of every pad, 5 is a common target.
+ * @param samples Readings per pad and setting.
+ * @return The profile applied, not valid if no setting meets the target (the one with the highest SNR is applied).
+ */
+TouchTuneProfile TouchSlider::autoTune(uint8_t targetSnr, uint8_t samples)
+{
+  if (!_sliderRunning) {
+    log_e("Start the touch slider before auto-tuning.");
+    return _tuneProfile;
+  }
+
+  uint8_t voltages[TUNE_MAX_VOLTAGES];
+  uint8_t numVoltages = TouchDriver::getNumVoltages();
+  if (numVoltages > TUNE_MAX_VOLTAGES)
+    numVoltages = TUNE_MAX_VOLTAGES;
+  for (uint8_t i = 0; i < numVoltages; ++i) {
+    voltages[i] = i;
+  }
+  uint8_t numCycles = 0;
+  const uint16_t* cycles = TouchDriver::getTuneMeasurementCycles(numCycles);
+
+  TouchSliderTuneSensor sensor;
+  for (uint8_t i = 0; i < TOUCH_PAD_MAX && sensor.numPads < TUNE_MAX_PADS; ++i) {
+    if (_padEnabled[i]) {
+      sensor.pads[sensor.numPads] = static_cast<touch_pad_t>(i);
+      sensor.thresholdPercent[sensor.numPads] = _padThresholdPercent[i];
+      sensor.numPads++;
+    }
+  }
+
+  TouchAutoTuner tuner(voltages, numVoltages, cycles, numCycles);
+  tuner.setTargetSnr(static_cast<uint16_t>(targetSnr) * TUNE_SNR_ONE);
+  tuner.setSamples(samples);
+
+  sliderTicker.detach();    // Pause the updates, the readings change with every setting
+  TouchTuneProfile profile = tuner.tune(sensor);
+
+  for (uint8_t i = 0; i < sensor.numPads; ++i) {
+    log_i("T%u: SNR %u.%02u", sensor.pads[i], tuner.getPadSnr(i) / TUNE_SNR_ONE, (tuner.getPadSnr(i) % TUNE_SNR_ONE) * 100 / TUNE_SNR_ONE);
+  }
+  if (!profile.valid)
+    log_w("No measurement setting reaches SNR %u, using the best one.", targetSnr);
+  log_i("Voltage range %u, measurement cycles %u, %u settings measured", profile.voltage, profile.measCycles, tuner.getMeasuredSettings());
+
+  TouchDriver::setVoltage(profile.voltage);
+  TouchDriver::setMeasurementCycles(profile.measCycles);
+  _tuneProfile = profile;
+  TouchPlatform::delayMs(TUNE_SETTLE_MS);    // Let the filter follow the new setting before calibrating
+  calibrate_thresholds();
+  sliderTicker.attach_ms(UPDATE_INTERVAL, timerCallback, this);
+  return profile;
+}
+
+/**
+ * @brief Apply a measurement profile.
+ *
+ * If the slider is running the thresholds are calibrated again, so the pads must not be touched.
+ *
+ * @param profile The profile, usually returned by autoTune() and restored from flash.
+ */
+void TouchSlider::setTuneProfile(const TouchTuneProfile &profile)
+{
+  if (profile.measCycles == 0 || profile.voltage >= TouchDriver::getNumVoltages())
+    return;
+
+  TouchDriver::setVoltage(profile.voltage);
+  TouchDriver::setMeasurementCycles(profile.measCycles);
+  _tuneProfile = profile;
+
+  if (_sliderRunning) {
+    TouchPlatform::delayMs(TUNE_SETTLE_MS);
+    calibrate_thresholds();
+  }
+}
+
+
+/**
+ * @brief Decode the segments of an interleaved slider.
+ *
+ * The channels of the layout are the slider pads, in the order of the constructor. The swipes, swipe fine, edges,
+ * contacts and the positions of the gesture classifier are reported in segments.
+ *
+ * The crosstalk compensation needs the pads in physical order, so it is disabled while a decoder is attached: the
+ * profile and a running calibration are dropped, and new ones are rejected.
+ *
+ * @param segmentDecoder The decoder, with a layout of _numSliderPins channels.
+ * @return true if the decoder was attached, false if its layout does not match the slider.
+ */
+bool TouchSlider::attachSegmentDecoder(TouchSegmentDecoder* segmentDecoder)
+{
+  if (segmentDecoder->getNumSegments() == 0 || segmentDecoder->getNumChannels() != _numSliderPins) {
+    log_e("The segment layout must use the %u slider pads as channels.", _numSliderPins);
+    return false;
+  }
+  if (_crosstalk.numPads != 0 || _crosstalkCalibrating) {
+    log_w("The crosstalk compensation is not available on an interleaved slider, it is disabled.");
+    _crosstalk.numPads = 0;
+    _crosstalkCalibrating = false;
+  }
+  segmentDecoder->reset();
+  _segmentDecoder = segmentDecoder;
+  return true;
+}
+
+/**
+ * @brief Start measuring the coupling between neighbour slider pads.
+ *
+ * Touch the center of each slider pad alone for a moment, one after the other, then call stopCrosstalkCalibration().
+ * The slider keeps running, with the previous compensation, while the coupling is measured. Not available with a
+ * segment decoder attached.
+ */
+void TouchSlider::startCrosstalkCalibration()
+{
+  if (_segmentDecoder != nullptr) {
+    log_e("The crosstalk compensation is not available on an interleaved slider.");
+    return;
+  }
+  for (uint8_t i = 0; i < _numSliderPins; ++i) {
+    _crosstalkMinLower[i] = UINT16_MAX;
+    _crosstalkMinUpper[i] = UINT16_MAX;
+    _crosstalkSamples[i] = 0;
+  }
+  _crosstalkCalibrating = true;
+}
+
+/**
+ * @brief Stop measuring the coupling and apply it.
+ *
+ * The coupling of a pair of pads is only updated if the pad that leaks was touched alone for CROSSTALK_MIN_SAMPLES scans.
+ *
+ * @return true if every slider pad was measured, false if the coupling of some pad was kept.
+ */
+bool TouchSlider::stopCrosstalkCalibration()
+{
+  if (!_crosstalkCalibrating)
+    return false;
+  _crosstalkCalibrating = false;
+
+  if (_crosstalk.numPads != _numSliderPins) {   // First calibration, start without coupling
+    _crosstalk = {};
+    _crosstalk.numPads = _numSliderPins;
+  }
+
+  bool complete = true;
+  TouchCrosstalkProfile profile = _crosstalk;
+  for (uint8_t i = 0; i < _numSliderPins; ++i) {
+    if (_crosstalkSamples[i] < CROSSTALK_MIN_SAMPLES) {
+      log_w("Slider pad %u was not touched alone, its crosstalk is not measured.", i);
+      complete = false;
+      continue;
+    }
+    if (i > 0)
+      profile.fromUpper[i - 1] = _crosstalkMinUpper[i - 1] < CROSSTALK_MAX_COUPLING ? _crosstalkMinUpper[i - 1] : CROSSTALK_MAX_COUPLING;
+    if (i + 1 < _numSliderPins)
+      profile.fromLower[i + 1] = _crosstalkMinLower[i + 1] < CROSSTALK_MAX_COUPLING ? _crosstalkMinLower[i + 1] : CROSSTALK_MAX_COUPLING;
+  }
+  _crosstalk = profile;
+  factorCrosstalk();
+  return complete;
+}
+
+/**
+ * @brief Apply a coupling profile between neighbour slider pads.
+ *
+ * @param profile The profile, usually returned by getCrosstalkProfile() after a calibration and restored from flash.
+ * Rejected with a segment decoder attached.
+ */
+void TouchSlider::setCrosstalkProfile(const TouchCrosstalkProfile &profile)
+{
+  if (_segmentDecoder != nullptr) {
+    log_e("The crosstalk compensation is not available on an interleaved slider.");
+    return;
+  }
+  if (profile.numPads != _numSliderPins) {
+    log_e("The crosstalk profile has %u pads, the slider has %u.", profile.numPads, _numSliderPins);
+    return;
+  }
+  TouchCrosstalkProfile clamped = profile;
+  for (uint8_t i = 0; i < _numSliderPins; ++i) {
+    if (clamped.fromLower[i] > CROSSTALK_MAX_COUPLING) clamped.fromLower[i] = CROSSTALK_MAX_COUPLING;
+    if (clamped.fromUpper[i] > CROSSTALK_MAX_COUPLING) clamped.fromUpper[i] = CROSSTALK_MAX_COUPLING;
+  }
+  _crosstalk = clamped;
+  factorCrosstalk();
+}
+
+/**
+ * @brief Set the reference pad of the slider.
+ *
+ * The reference is a touch pad that is never touched (a shielded dummy electrode, or a pad out of reach), scanned with
+ * the other pads. Temperature and supply ripple move every pad together, so the change of the reference, as a fraction
+ * of its baseline, is removed from the deltas of every other pad before they are compared with their thresholds.
+ * Touching the reference hides the touches of the slider.
+ *
+ * @param referencePin The GPIO pin of the reference pad, GPIO_NUM_NC to remove the reference.
+ */
+void TouchSlider::setReferencePad(gpio_num_t referencePin)
+{
+  if (_sliderRunning) {
+    log_w("Stop the slider before changing the reference pad.");
+    return;
+  }
+
+  if (referencePin != GPIO_NUM_NC) {
+    for (uint8_t i = 0; i < _numSliderPins; ++i) {      // Check if the pin is already in the list of sliders
+      if (_arraySliderPins[i] == referencePin) {
+        log_e("Reference %d is already in the list of sliders.", referencePin);
+        return;
+      }
+    }
+    for (uint8_t i = 0; i < _numTouchButtons; ++i) {    // Check if the pin is already in the list of touch buttons
+      if (_arrayButtonPins[i] == referencePin) {
+        log_e("Reference %d is already in the list of touch buttons.", referencePin);
+        return;
+      }
+    }
+    if (TouchDriver::mapGpioToTouchPad(referencePin) == TOUCH_PAD_MAX) {
+      log_e("GPIO pin %d is not a valid touch pad.", referencePin);
+      return;
+    }
+  }
+
+  if (_referencePad != TOUCH_PAD_MAX)
+    _padEnabled[_referencePad] = false;     // Release the previous reference
+  _referencePin = referencePin;
+  _referencePad = referencePin != GPIO_NUM_NC ? TouchDriver::mapGpioToTouchPad(referencePin) : TOUCH_PAD_MAX;
+  _referenceCompensation = 0;
+  if (_referencePad != TOUCH_PAD_MAX)
+    log_i("Reference pad set on TouchPin %d.", _referencePad);
+}
+
+
 /*********************** PRIVATE FUNCTIONS **********************/
 /**
  * @brief  Set a touch pad input
@@ -348,6 +812,9 @@ void TouchSlider::setDefaultConfiguration()
   #ifdef START_WITH_TOUCH_BUTTONS
     enableTouchButtons();             // Enable touch buttons
   #endif 
+  #ifdef START_PRINT_TOUCH_BUTTONS
+    enablePrintButtonTouched();       // Enable print touch buttons
+  #endif
 
 }
 
@@ -360,26 +827,34 @@ void TouchSlider::setDefaultConfiguration()
 void TouchSlider::begin() {
   log_i("Initializing touch slider...");
   _sliderRunning = true;      // Mark that the slider is running
+  _simulating = false;        // Read the touch pads again after a simulation
 
-  for (uint8_t i = 0; i < TOUCH_PAD_MAX; ++i) {     // Configure enabled touch pads with the specified inactive threshold
+  for (uint8_t i = 0; i < TOUCH_PAD_MAX; ++i) {     // Configure enabled touch pads
     if (_padEnabled[i]) {
-      touch_pad_config(static_cast<touch_pad_t>(i), threshold_inactive);    // (touch_pad_t) i
+      TouchDriver::configPad(static_cast<touch_pad_t>(i));    // (touch_pad_t) i
     }
   }
-  // Initialize and start a software filter to detect slight change of capacitance.
-  touch_pad_filter_start(filter_period);
-  touch_pad_set_filter_read_cb(filter_read_cb);
+  // Initialize and start the filter to detect slight change of capacitance (v1: software filter, v2: hardware filter)
+  TouchDriver::start(filter_period, filter_read_cb);
 
   #ifdef START_WITH_CALIBRATION    // Start calibration if enabled (Check TouchSlider.h on LIBRARY OPTIONS)
     calibrate_thresholds();   // Calibrate the touch thresholds
   #endif
-  sliderTicker.attach_ms(UPDATE_INTERVAL, update, this);    // Attach a timer interrupt to periodically update the slider
+  sliderTicker.attach_ms(UPDATE_INTERVAL, timerCallback, this);    // Attach a timer interrupt to periodically update the slider
   log_i("Touch slider initialized!");
 }
 
+/**
+ * @brief Callback of the scan timer, runs in the esp_timer task.
+ * @param arg Pointer to the TouchSlider instance.
+ */
+void TouchSlider::timerCallback(void *arg) {
+  update(static_cast<TouchSlider*>(arg));
+}
+
 /**
  * @brief  Update the touch pads states
- * This method is called periodically by a ticker
+ * This method is called periodically by the scan timer
  */
 void TouchSlider::update(TouchSlider* self) {
   bool padTouchedFound = false;
@@ -387,10 +862,31 @@ void TouchSlider::update(TouchSlider* self) {
   int8_t lastTouchedIndex = -1;
   uint8_t touchedPadCount = 0;
 
+  if(self->_simulating) {   // The values are injected, the time of a scan is the nominal interval
+    self->_metrics.recordScan(self->UPDATE_INTERVAL * 1000UL, self->UPDATE_INTERVAL * 1000UL);
+  } else {
+    int64_t scanTimeUs = TouchPlatform::getTimeUs();
+    if(self->_lastScanTimeUs != 0) {    // Measure the scan interval for the jitter metrics
+      self->_metrics.recordScan(scanTimeUs - self->_lastScanTimeUs, self->UPDATE_INTERVAL * 1000UL);
+    }
+    self->_lastScanTimeUs = scanTimeUs;
+    readPadValues();    // Refresh the pad values when they are not delivered by the filter callback
+  }
+  updatePadDeltas(self);                // Touch decisions use the compensated deltas
+  if(self->_gestureRecognizer != nullptr) {
+    self->_gestureRecognizer->tick();   // Advance the time between strokes of the gestures in progress
+  }
+
   // Check touch status and count touched pads
   checkSliderStatus(self, padTouchedFound, firstTouchedIndex, lastTouchedIndex, touchedPadCount);
+  checkProximity(self, padTouchedFound);
+  if(self->_segmentDecoder != nullptr) {    // Interleaved slider, the positions are the segments and not the pads
+    padTouchedFound = decodeSegments(self, firstTouchedIndex, lastTouchedIndex, touchedPadCount);
+  }
 
   if (!padTouchedFound) { // Handle the cases when no pad is touched
+    self->_numContacts = 0;
+    self->_twoFingerLast = false;
     handleNoTouch(self);
   } else {  // Handle the case when at least one pad is touched
     handleTouch(self, firstTouchedIndex, lastTouchedIndex, touchedPadCount);
@@ -400,6 +896,252 @@ void TouchSlider::update(TouchSlider* self) {
     checkButtonStatus(self);          // Check if touch buttons are touched
     checkSingleButtonTouch(self);     // Check for a single touch and release of a button
   }
+
+  recordPadMetrics(self);             // Record the pad health
+  streamMetrics(self);                // Write a metrics frame if the period has elapsed
+}
+
+/**
+ * @brief Record the baseline, filtered value and noise of the enabled pads in the metrics registry.
+ *
+ * @param self Pointer to the TouchSlider instance.
+ */
+void TouchSlider::recordPadMetrics(TouchSlider* self) {
+  for (uint8_t i = 0; i < TOUCH_PAD_MAX; ++i) {
+    if (_padEnabled[i]) {
+      self->_metrics.recordPad(i, _padBaseline[i], _padFilteredValue[i], isPadTouched(static_cast<touch_pad_t>(i)));
+    }
+  }
+}
+
+/**
+ * @brief Prepare a metrics frame for flushMetrics() when the period has elapsed.
+ *
+ * The frame is only encoded here, it is never written from the slider timer. A frame that flushMetrics() could not write
+ * is counted as dropped and replaced. While the previous frame is still waiting for flushMetrics() the new one is
+ * dropped, so the buffer is never changed while it is being written.
+ *
+ * @param self Pointer to the TouchSlider instance.
+ */
+void TouchSlider::streamMetrics(TouchSlider* self) {
+  if (self->_metricsWriter == nullptr || ++self->_scansSinceFrame < self->_metricsPeriodScans)
+    return;
+  self->_scansSinceFrame = 0;
+
+  if (self->_metricsFrameState == METRICS_FRAME_READY) {    // Not written yet, drop the new frame
+    self->_metrics.increment(METRIC_DROPPED_FRAMES);
+    return;
+  }
+  if (self->_metricsFrameState == METRICS_FRAME_FAILED)     // Written partially or not at all
+    self->_metrics.increment(METRIC_DROPPED_FRAMES);
+
+  self->_metricsFrameLength = self->_metrics.encodeFrame(self->_metricsFrame, sizeof(self->_metricsFrame), TouchPlatform::getTimeUs() / 1000);
+  self->_metricsFrameState = self->_metricsFrameLength > 0 ? METRICS_FRAME_READY : METRICS_FRAME_EMPTY;
+}
+
+/**
+ * @brief Read the filtered values and baselines of the enabled touch pads.
+ *
+ * On ESP32 (v1) the filtered values are delivered by filter_read_cb and the baseline is fixed at calibration, so nothing is done.
+ * On ESP32-S2/S3 (v2) the hardware smooth value and the hardware benchmark are read once per scan.
+ */
+void TouchSlider::readPadValues() {
+  if (!TouchDriver::tracksBaseline())
+    return;
+
+  for (uint8_t i = 0; i < TOUCH_PAD_MAX; ++i) {
+    if (_padEnabled[i]) {
+      _padFilteredValue[i] = TouchDriver::readFiltered(static_cast<touch_pad_t>(i));
+      _padBaseline[i] = TouchDriver::readBaseline(static_cast<touch_pad_t>(i));
+    }
+  }
+}
+
+/**
+ * @brief Refresh the deltas of the enabled touch pads, and compensate the common-mode drift and the crosstalk between
+ * the slider pads.
+ *
+ * @param self Pointer to the TouchSlider instance.
+ */
+void TouchSlider::updatePadDeltas(TouchSlider* self) {
+  for (uint8_t i = 0; i < TOUCH_PAD_MAX; ++i) {
+    if (_padEnabled[i]) {
+      _padDelta[i] = TouchDriver::touchDelta(_padFilteredValue[i], _padBaseline[i]);
+    }
+  }
+
+  if (self->_referencePad != TOUCH_PAD_MAX)
+    compensateCommonMode(self);         // Drift first, the crosstalk is a fraction of the touch signal only
+
+  if (self->_crosstalkCalibrating)
+    measureCrosstalk(self);             // The coupling is measured on the deltas without compensation
+  if (self->_crosstalk.numPads == self->_numSliderPins)
+    decoupleSliderPads(self);
+}
+
+/**
+ * @brief Remove the common-mode drift measured by the reference pad from the deltas of the other enabled pads.
+ *
+ * The change of the reference is taken as a fraction of its baseline and scaled to the baseline of each pad, so pads
+ * of different sizes get a proportional correction. A drift away from touch is compensated too: it raises the deltas
+ * that it was hiding. The compensation is recorded in the metrics registry.
+ *
+ * @param self Pointer to the TouchSlider instance.
+ */
+void TouchSlider::compensateCommonMode(TouchSlider* self) {
+  touch_pad_t reference = self->_referencePad;
+  if (_padBaseline[reference] == 0)
+    return;
+
+  int64_t drift = static_cast<int64_t>(TouchDriver::touchChange(_padFilteredValue[reference], _padBaseline[reference])) * 65536 / _padBaseline[reference];   // Q16
+  for (uint8_t i = 0; i < TOUCH_PAD_MAX; ++i) {
+    if (_padEnabled[i] && i != reference) {
+      int64_t change = TouchDriver::touchChange(_padFilteredValue[i], _padBaseline[i]) - static_cast<int64_t>(_padBaseline[i]) * drift / 65536;
+      _padDelta[i] = change > 0 ? static_cast<uint32_t>(change) : 0;
+    }
+  }
+
+  int64_t basisPoints = drift * 10000 / 65536;
+  if (basisPoints > INT16_MAX) basisPoints = INT16_MAX;
+  if (basisPoints < INT16_MIN) basisPoints = INT16_MIN;
+  self->_referenceCompensation = static_cast<int16_t>(basisPoints);
+  self->_metrics.recordCommonMode(self->_referenceCompensation);
+}
+
+/**
+ * @brief Measure the coupling of the slider pad touched alone.
+ *
+ * The pad with the highest delta is taken as touched if it is above its threshold. Its neighbours only see crosstalk
+ * when the finger is on the center of the pad, so the lowest ratio seen is kept and touches off the center do not
+ * count as coupling.
+ *
+ * @param self Pointer to the TouchSlider instance.
+ */
+void TouchSlider::measureCrosstalk(TouchSlider* self) {
+  uint8_t touched = 0;
+  for (uint8_t i = 1; i < self->_numSliderPins; ++i) {
+    if (_padDelta[self->_arraySliderPads[i]] > _padDelta[self->_arraySliderPads[touched]])
+      touched = i;
+  }
+  touch_pad_t pad = self->_arraySliderPads[touched];
+  if (_padDelta[pad] <= _padThreshold[pad])
+    return;
+
+  if (touched > 0) {    // The previous pad sees the next one (this pad)
+    uint32_t coupling = static_cast<uint64_t>(_padDelta[self->_arraySliderPads[touched - 1]]) * 256 / _padDelta[pad];
+    if (coupling < self->_crosstalkMinUpper[touched - 1]) self->_crosstalkMinUpper[touched - 1] = coupling;
+  }
+  if (touched + 1 < self->_numSliderPins) {   // The next pad sees the previous one (this pad)
+    uint32_t coupling = static_cast<uint64_t>(_padDelta[self->_arraySliderPads[touched + 1]]) * 256 / _padDelta[pad];
+    if (coupling < self->_crosstalkMinLower[touched + 1]) self->_crosstalkMinLower[touched + 1] = coupling;
+  }
+  if (self->_crosstalkSamples[touched] < UINT8_MAX) self->_crosstalkSamples[touched]++;
+}
+
+/**
+ * @brief Remove the crosstalk from the deltas of the slider pads.
+ *
+ * The measured deltas are the true ones plus a fraction of the neighbours, a tridiagonal coupling matrix with ones on
+ * the diagonal. It is solved exactly with the factors of factorCrosstalk(): a forward pass removes the coupling from
+ * the previous pads and a backward pass the coupling from the next ones (Thomas algorithm), two multiplications and a
+ * division per pad. Deltas are kept in Q8 between the passes, negative results are clamped to 0.
+ *
+ * @param self Pointer to the TouchSlider instance.
+ */
+void TouchSlider::decoupleSliderPads(TouchSlider* self) {
+  uint8_t numPads = self->_numSliderPins;
+  int64_t solution[TOUCH_PAD_MAX];    // Q8 counts
+
+  int64_t previous = 0;
+  for (uint8_t i = 0; i < numPads; ++i) {   // Forward: remove the coupling from the previous pads
+    int64_t measured = static_cast<int64_t>(_padDelta[self->_arraySliderPads[i]]) * 256;
+    if (i > 0) measured -= self->_crosstalk.fromLower[i] * previous / 256;
+    previous = measured * 65536 / self->_crosstalkPivot[i];
+    solution[i] = previous;
+  }
+  for (int8_t i = numPads - 2; i >= 0; --i) {   // Backward: remove the coupling from the next pads
+    solution[i] -= self->_crosstalkUpper[i] * solution[i + 1] / 65536;
+  }
+
+  for (uint8_t i = 0; i < numPads; ++i) {
+    _padDelta[self->_arraySliderPads[i]] = solution[i] > 0 ? static_cast<uint32_t>(solution[i] / 256) : 0;
+  }
+}
+
+/**
+ * @brief Factor the coupling matrix of the crosstalk profile for decoupleSliderPads().
+ *
+ * Called every time the profile changes, so a scan only runs the substitutions. A pivot below CROSSTALK_MIN_PIVOT
+ * (couplings that add up to more than the signal of the pad) is raised to it.
+ */
+void TouchSlider::factorCrosstalk() {
+  int64_t upper = 0;    // Factor of the previous row (Q16)
+  for (uint8_t i = 0; i < _crosstalk.numPads; ++i) {
+    int64_t pivot = 65536;
+    if (i > 0) pivot -= _crosstalk.fromLower[i] * upper / 256;
+    if (pivot < CROSSTALK_MIN_PIVOT * 256) pivot = CROSSTALK_MIN_PIVOT * 256;
+    upper = static_cast<int64_t>(_crosstalk.fromUpper[i]) * 65536 * 256 / pivot;
+    _crosstalkPivot[i] = static_cast<int32_t>(pivot);
+    _crosstalkUpper[i] = static_cast<int32_t>(upper);
+  }
+}
+
+/**
+ * @brief Check if a touch pad is touched based on the filtered value and threshold.
+ * @param pad The touch pad to check.
+ * @retval true: The touch pad is touched
+ */
+bool TouchSlider::isPadTouched(touch_pad_t pad) {
+  return _padDelta[pad] > _padThreshold[pad];
+}
+
+/**
+ * @brief Calculate the proximity threshold of the slider pads from their baselines.
+ *
+ * The proximity threshold is never above the touch threshold, so a touched pad is always near.
+ */
+void TouchSlider::calculateProximityThresholds() {
+  for (uint8_t i = 0; i < _numSliderPins; ++i) {
+    touch_pad_t pad = _arraySliderPads[i];
+    uint32_t proximity = TouchDriver::thresholdFromBaseline(_padBaseline[pad], _proximityPercent);
+    _padProximityThreshold[pad] = proximity < _padThreshold[pad] ? proximity : _padThreshold[pad];
+  }
+}
+
+/**
+ * @brief Check if a finger is near the slider pads.
+ *
+ * The slider becomes near as soon as one pad passes its proximity threshold, and away after PROXIMITY_RELEASE_SCANS
+ * scans without any pad near it.
+ *
+ * @param self Pointer to the TouchSlider instance.
+ * @param padTouchedFound Indicates whether a slider pad is touched on this scan.
+ */
+void TouchSlider::checkProximity(TouchSlider* self, bool padTouchedFound) {
+  if (self->_proximityPercent == 0)
+    return;
+
+  bool near = padTouchedFound;
+  for (uint8_t i = 0; i < self->_numSliderPins && !near; ++i) {
+    touch_pad_t pad = self->_arraySliderPads[i];
+    near = _padDelta[pad] > _padProximityThreshold[pad];
+  }
+
+  if (near) {
+    self->_scansAway = 0;
+    if (!self->_sliderNear) {   // The finger arrived
+      self->_sliderNear = true;
+      if (!padTouchedFound) {
+        self->_hoverDetected = true;
+        self->_metrics.increment(METRIC_HOVERS);
+        if(self->_enablePrintSwipeStatus) LOGIY("HOVER");
+      }
+      if (self->_proximityCallback != nullptr) self->_proximityCallback(true);
+    }
+  } else if (self->_sliderNear && ++self->_scansAway >= PROXIMITY_RELEASE_SCANS) {    // The finger went away
+    self->_sliderNear = false;
+    if (self->_proximityCallback != nullptr) self->_proximityCallback(false);
+  }
 }
 
 /**
@@ -413,7 +1155,7 @@ void TouchSlider::checkButtonStatus(TouchSlider* self) {
   for (uint8_t i = 0; i < self->_numTouchButtons; ++i) {  // Loop through the button pins to check their touch status
     if (_padEnabled[self->_arrayButtonPads[i]]) {
       // Check if the touch pad is touched based on the filtered value and threshold
-      self->_ButtonTouched[i] = _padFilteredValue[self->_arrayButtonPads[i]] < _padThreshold[self->_arrayButtonPads[i]];  
+      self->_ButtonTouched[i] = isPadTouched(self->_arrayButtonPads[i]);
     }
   }
 }
@@ -437,10 +1179,13 @@ void TouchSlider::checkSingleButtonTouch(TouchSlider* self) {
 
   if (buttonTouched && !self->_ButtonTouched[getIndexFromGpioButton(self, gpioButtonTouched)]) {      // If a single button touch is detected and that button is released
     
+    if(self->_gpioButtonTouched != GPIO_NUM_NC)                                                       // The previous press was not read
+      self->_metrics.increment(METRIC_DROPPED_EVENTS);
     self->_gpioButtonTouched = gpioButtonTouched;                                                     // Set the touched button index
+    self->_metrics.increment(METRIC_BUTTON_PRESSES);
 
     if(self->_enablePrintBottonTouched) 
-      LOGIG("GPIO Button Touched: %s", String(self->_gpioButtonTouched).c_str());        // Print the gpio pin of the button that was touched
+      LOGIG("GPIO Button Touched: %d", self->_gpioButtonTouched);        // Print the gpio pin of the button that was touched
 
     buttonTouched = false;                                                                            // Reset the state
     gpioButtonTouched = GPIO_NUM_NC;                                                                  // Reset the gpio pin of the button that was touched
@@ -488,7 +1233,7 @@ void TouchSlider::checkSliderStatus(TouchSlider* self, bool& padTouchedFound, in
   for (uint8_t i = 0; i < self->_numSliderPins; ++i) {  // Loop through the slider pins to check their touch status
     if (_padEnabled[self->_arraySliderPads[i]]) {
       // Check if the touch pad is touched based on the filtered value and threshold
-      self->_SliderTouched[i] = _padFilteredValue[self->_arraySliderPads[i]] < _padThreshold[self->_arraySliderPads[i]];  
+      self->_SliderTouched[i] = isPadTouched(self->_arraySliderPads[i]);
       if (self->_SliderTouched[i]) {
         touchedPadCount++; // Increment the touched pad count if this pad is touched
       }
@@ -505,6 +1250,13 @@ void TouchSlider::checkSliderStatus(TouchSlider* self, bool& padTouchedFound, in
     }
     self->_lastValue = self->_actualValue;  // Store the last value for reference
   }
+
+  if (padTouchedFound && self->_segmentDecoder == nullptr && touchedPadCount < lastTouchedIndex - firstTouchedIndex + 1) {
+    self->_metrics.increment(METRIC_SPLIT_TOUCH_SCANS);     // Untouched pads between touched pads
+  }
+  if (self->_numSliderPins > 2 && touchedPadCount == self->_numSliderPins) {
+    self->_metrics.increment(METRIC_ALL_PADS_SCANS);        // Every pad touched at once, usually a common-mode change
+  }
 }
 
 /**
@@ -517,16 +1269,28 @@ void TouchSlider::handleNoTouch(TouchSlider* self) {
     self->_sliderValue[i] = 0;  // Reset slider values and set actual value to 0
   }
   self->_actualValue = 0;
+  if(!self->firstTouch) {    // The finger left the slider
+    self->extrapolateSwipe();
+    if(self->_valueMapper != nullptr) self->_valueMapper->release();
+    self->emitStroke(STROKE_RELEASE);
+    if(self->_gestureClassifier != nullptr) {
+      uint8_t classId = self->_gestureClassifier->end();    // Classify the touch episode
+      if(classId != CLASSIFIER_NONE && self->_enablePrintSwipeStatus) LOGIC("GESTURE CLASS %u", classId);
+    }
+    if(self->_touchScans <= 1) self->_metrics.increment(METRIC_SHORT_TOUCHES);
+  }
   self->firstTouch = true;
 
   if(self->_enableSwipeFine) {    // Check if that functionality Swipe Fine is active 
     // Increment swipe counts if the first pad touched was top or bottom
     if(self->firstPadTop) {
-      self->_swipeFineUpCount++;
+      countEvent(self, self->_swipeFineUpCount, METRIC_SWIPE_FINE_UP);
+      if(self->_valueMapper != nullptr) self->_valueMapper->nudge(-1);
       if(self->_enablePrintSwipeStatus) LOGIB("SWIPE FINE UP");
     }
     if(self->firstPadBot) {
-      self->_swipeFineDownCount++;
+      countEvent(self, self->_swipeFineDownCount, METRIC_SWIPE_FINE_DOWN);
+      if(self->_valueMapper != nullptr) self->_valueMapper->nudge(1);
       if(self->_enablePrintSwipeStatus) LOGIR("SWIPE FINE DOWN");
     }
   }
@@ -544,33 +1308,171 @@ void TouchSlider::handleNoTouch(TouchSlider* self) {
  */
 void TouchSlider::handleTouch(TouchSlider* self, int8_t firstTouchedIndex, int8_t lastTouchedIndex, uint8_t touchedPadCount) {
   if(self->firstTouch == true) {  // Check if this is the first entry into this condition block
+    self->_scansSinceMove = 0;
+    self->_swipeDirection = 0;
+    self->_touchScans = 0;
+    self->_metrics.increment(METRIC_TOUCHES);
   if(self->_enablePrintSliderTouched) self->printSliderTouched();       // Check if _enablePrintSliderTouched is true for a Print SliderTouched[] 
     if(touchedPadCount == 1) {    // Check if only one pad is touched
-      if (self->_SliderTouched[0] == true) {  
+      if (firstTouchedIndex == 0) {  
         self->firstPadBot = true;
         if(self->_enablePrintSwipeStatus) LOGIR("FIRST TOUCH BOT");
       }
-      if(self->_SliderTouched[self->_numSliderPins - 1] == true) {
+      if(lastTouchedIndex == self->getNumPositions() - 1) {
         self->firstPadTop = true;
         if(self->_enablePrintSwipeStatus) LOGIB("FIRST TOUCH TOP");
       }
     }
+    if(self->firstPadBot) self->emitStroke(STROKE_TOUCH_BOT);         // Report where the touch started
+    else if(self->firstPadTop) self->emitStroke(STROKE_TOUCH_TOP);
+    else self->emitStroke(STROKE_TOUCH_MID);
+    if(self->_gestureClassifier != nullptr) self->_gestureClassifier->begin(self->UPDATE_INTERVAL);
   }
 
+  uint8_t numContacts = self->_segmentDecoder != nullptr ? self->_numContacts : segmentContacts(self);   // The decoder found a single contact
+  if(self->_gestureClassifier != nullptr) self->feedClassifier(numContacts);
+  if(numContacts == 2) {   // Two fingers, the single finger gestures would see one huge finger
+    self->_lastSwipeStep = 0;
+    self->analyzeTwoFingerGesture();
+    self->_twoFingerLast = true;
+    if(self->_touchScans < UINT16_MAX) self->_touchScans++;
+    self->firstTouch = false;
+    return;
+  }
+  bool resumeSingle = self->_twoFingerLast;   // One of the two fingers left the slider
+  self->_twoFingerLast = false;
+
   // Calculate slider values based on touched pads
-  for (uint8_t i = 0; i < self->_numSliderPins; ++i) {
-    if (i >= firstTouchedIndex && i <= lastTouchedIndex) {
-      self->_sliderValue[i] = 0;
-    } else if (i < firstTouchedIndex) {
-      self->_sliderValue[i] = -1;
-    } else if (i > lastTouchedIndex) {
-      self->_sliderValue[i] = 1;
+  if (self->_segmentDecoder == nullptr) {    // Interleaved slider, analyzeGesture() takes the decoded position
+    for (uint8_t i = 0; i < self->_numSliderPins; ++i) {
+      if (i >= firstTouchedIndex && i <= lastTouchedIndex) {
+        self->_sliderValue[i] = 0;
+      } else if (i < firstTouchedIndex) {
+        self->_sliderValue[i] = -1;
+      } else if (i > lastTouchedIndex) {
+        self->_sliderValue[i] = 1;
+      }
+    }
+  }
+  if(resumeSingle) {    // Take the remaining finger as the new reference, so lifting a finger is not a swipe
+    self->_lastValue = 0;
+    for (uint8_t i = 0; i < self->_numSliderPins; ++i) {
+      self->_lastValue += self->_sliderValue[i];
     }
+    self->_scansSinceMove = 0;
+    self->_swipeDirection = 0;
+  }
+  if(!self->firstTouch && self->_scansSinceMove < UINT16_MAX) self->_scansSinceMove++;   // Scan intervals, the first touch is the start
+  if(self->_touchScans < UINT16_MAX) self->_touchScans++;
+  self->analyzeGesture(self->getNumPositions());   // Analyze the gesture based on the slider values
+  if(self->_gestureRecognizer != nullptr && self->_scansSinceMove == self->_gestureRecognizer->getHoldScans()) {
+    self->emitStroke(STROKE_HOLD);              // Touched without swiping for the hold time
   }
-  self->analyzeGesture(self->_numSliderPins);   // Analyze the gesture based on the slider values
   self->firstTouch = false;
 }
 
+/**
+ * @brief Report the pad deltas of a touched scan to the gesture classifier.
+ *
+ * The channels of an interleaved slider are not in physical order, so the decoded segment position is reported
+ * instead of the deltas.
+ *
+ * @param numContacts Separate contacts found on the scan.
+ */
+void TouchSlider::feedClassifier(uint8_t numContacts) {
+  if (_segmentDecoder != nullptr) {
+    uint32_t peakPercent = 0;
+    for (uint8_t i = 0; i < _numSliderPins; ++i) {
+      touch_pad_t pad = _arraySliderPads[i];
+      if (_padThreshold[pad] == 0)
+        continue;
+      uint32_t percent = static_cast<uint32_t>(static_cast<uint64_t>(_padDelta[pad]) * 100 / _padThreshold[pad]);
+      if (percent > peakPercent) peakPercent = percent;
+    }
+    uint8_t width = _contacts[0].lastPad - _contacts[0].firstPad + 1;
+    _gestureClassifier->addPosition(_contacts[0].position, 2 * (_segmentDecoder->getNumSegments() - 1), peakPercent, width, numContacts);
+    return;
+  }
+
+  uint32_t deltas[TOUCH_PAD_MAX];
+  uint32_t thresholds[TOUCH_PAD_MAX];
+  for (uint8_t i = 0; i < _numSliderPins; ++i) {
+    touch_pad_t pad = _arraySliderPads[i];
+    deltas[i] = _padDelta[pad];
+    thresholds[i] = _padThreshold[pad];
+  }
+  _gestureClassifier->addScan(deltas, thresholds, _numSliderPins, numContacts);
+}
+
+/**
+ * @brief Resolve the touched segments of an interleaved slider from the touched pads (channels).
+ *
+ * The contact is stored as the first contact, in segments. Touches that can not be resolved yet are not reported.
+ *
+ * @param self Pointer to the TouchSlider instance.
+ * @param firstTouchedIndex Set to the first touched segment.
+ * @param lastTouchedIndex Set to the last touched segment.
+ * @param touchedPadCount Set to the number of touched segments.
+ * @return true if a segment is touched.
+ */
+bool TouchSlider::decodeSegments(TouchSlider* self, int8_t& firstTouchedIndex, int8_t& lastTouchedIndex, uint8_t& touchedPadCount) {
+  uint32_t deltas[TOUCH_PAD_MAX];
+  for (uint8_t i = 0; i < self->_numSliderPins; ++i) {
+    deltas[i] = _padDelta[self->_arraySliderPads[i]];
+  }
+
+  if (!self->_segmentDecoder->decode(deltas, self->_SliderTouched)) {
+    self->_numContacts = 0;
+    return false;
+  }
+
+  firstTouchedIndex = self->_segmentDecoder->getFirstSegment();
+  lastTouchedIndex = self->_segmentDecoder->getLastSegment();
+  touchedPadCount = lastTouchedIndex - firstTouchedIndex + 1;
+  self->_contacts[0].firstPad = firstTouchedIndex;
+  self->_contacts[0].lastPad = lastTouchedIndex;
+  self->_contacts[0].position = self->_segmentDecoder->getPosition();
+  self->_numContacts = 1;
+  return true;
+}
+
+/**
+ * @brief Get the positions of the slider.
+ * @return The number of slider pads, or the number of segments when a segment decoder is attached.
+ */
+uint8_t TouchSlider::getNumPositions() {
+  return _segmentDecoder != nullptr ? _segmentDecoder->getNumSegments() : _numSliderPins;
+}
+
+/**
+ * @brief Split the touched pads of the slider in contiguous runs (contacts).
+ *
+ * Up to two contacts are tracked. If noise splits the touch in more runs, the outermost runs are kept.
+ *
+ * @param self Pointer to the TouchSlider instance.
+ * @return The number of contacts found (0, 1 or 2).
+ */
+uint8_t TouchSlider::segmentContacts(TouchSlider* self) {
+  uint8_t numRuns = 0;
+  for (uint8_t i = 0; i < self->_numSliderPins; ++i) {
+    if (!self->_SliderTouched[i] || (i > 0 && self->_SliderTouched[i - 1]))
+      continue;   // Not the start of a run
+
+    uint8_t last = i;
+    while (last + 1 < self->_numSliderPins && self->_SliderTouched[last + 1]) {
+      ++last;
+    }
+    uint8_t slot = numRuns < 2 ? numRuns : 1;   // Keep the first run and the last one
+    self->_contacts[slot].firstPad = i;
+    self->_contacts[slot].lastPad = last;
+    self->_contacts[slot].position = i + last;
+    ++numRuns;
+  }
+
+  self->_numContacts = numRuns < 2 ? numRuns : 2;
+  return self->_numContacts;
+}
+
 /**
  * @brief Get the index of a slider pin based on its GPIO pin number.
  *
@@ -610,34 +1512,168 @@ uint8_t TouchSlider::getIndexFromGpioButton(TouchSlider* self, gpio_num_t gpioPi
  *
  * This function analyzes the states of the slider touch pads to detect swipe gestures (up or down).
  * It calculates the actual value based on slider values and compares it to the previous value to determine the gesture.
+ * The whole movement and its speed are passed to the value mapper, if one is attached.
  * Detected gestures are logged for monitoring purposes.
  *
  * @param numSliders The number of slider touch pads to analyze.
  */
 void TouchSlider::analyzeGesture(uint8_t numSliders) {
   _actualValue = 0;
-  for (uint8_t i = 0; i < numSliders; ++i) {    // Calculate the actual value by summing slider values
-    _actualValue += _sliderValue[i];
+  if (_segmentDecoder != nullptr) {               // One value per segment below (-1) and above (1) the contact, like the slider values
+    _actualValue = numSliders - 1 - _contacts[0].position;
+  } else {
+    for (uint8_t i = 0; i < numSliders; ++i) {    // Calculate the actual value by summing slider values
+      _actualValue += _sliderValue[i];
+    }
+  }
+
+  int16_t change = _actualValue - _lastValue;
+  if (change != 0 && !firstTouch && change * _swipeDirection < 0 && change > -SWIPE_REVERSAL_STEPS && change < SWIPE_REVERSAL_STEPS) {
+    _actualValue = _lastValue;                                // Half a pad back, hold the position until the reversal is a full pad
   }
 
   if (_actualValue != _lastValue && !firstTouch) {            // Check if there is no change or it's the first touch
     if(_enablePrintSliderTouched) printSliderTouched();       // Check if _enablePrintSliderTouched is true for a Print SliderTouched[] 
     _swipeCount = _actualValue - _lastValue;                  // Calculate the swipe count and determine the gesture
+    uint8_t steps = _swipeCount > 0 ? _swipeCount : -_swipeCount;   // Keep the whole distance, a fast finger skips pads between scans
+    _lastSwipeStep = _swipeCount;
+    _lastSwipeScans = _scansSinceMove;
+    if(_valueMapper != nullptr) {                             // Map the whole movement in half pad steps, its speed comes from the scans since the last swipe
+      uint32_t elapsedMs = static_cast<uint32_t>(_scansSinceMove) * UPDATE_INTERVAL;
+      _valueMapper->move(_swipeCount, elapsedMs > UINT16_MAX ? UINT16_MAX : elapsedMs);
+    }
+    _scansSinceMove = 0;
+    _swipeDirection = _swipeCount > 0 ? 1 : -1;
     if (_swipeCount > 0) {
       _sliderState = SWIPE_DOWN;
-      _swipeDownCount++;
+      countEvent(this, _swipeDownCount, METRIC_SWIPE_DOWN, steps);
       resetFirstTouches();
+      emitStroke(STROKE_SWIPE_DOWN);
       if(_enablePrintSwipeStatus) LOGIR("SWIPE DOWN");
     } else if (_swipeCount < 0) {
       _sliderState = SWIPE_UP;
-      _swipeUpCount++;
+      countEvent(this, _swipeUpCount, METRIC_SWIPE_UP, steps);
       resetFirstTouches();
+      emitStroke(STROKE_SWIPE_UP);
       if(_enablePrintSwipeStatus) LOGIB("SWIPE_UP");
     } else {
       _sliderState = NO_CHANGE;
     }
   } else {
     _sliderState = NO_CHANGE;
+    _lastSwipeStep = 0;
+  }
+}
+
+/**
+ * @brief Extrapolate the movement of a fast swipe after the last scan.
+ *
+ * Only a finger that skipped pads on the last scan (a step longer than one pad) is extrapolated: it kept moving until it
+ * lifted, on average half a scan later. The steps added are its speed (last step / scans it took) times half a scan,
+ * rounded down and limited by the pads left before the edge of the slider. A finger moving a pad or less per scan can
+ * not be told from one that stopped before lifting, so it is not extrapolated.
+ */
+void TouchSlider::extrapolateSwipe() {
+  int8_t lastStep = _lastSwipeStep;
+  uint16_t lastScans = _lastSwipeScans;
+  _lastSwipeStep = 0;
+  _lastSwipeScans = 0;
+  uint8_t absStep = lastStep > 0 ? lastStep : -lastStep;
+  if (absStep <= 2 || lastScans == 0)   // Two steps per pad, no pad was skipped
+    return;
+
+  uint16_t steps = absStep / (2 * lastScans);  // absStep / (lastScans * UPDATE_INTERVAL) steps per ms during UPDATE_INTERVAL / 2
+  uint8_t room = lastStep > 0 ? 2 * _contacts[0].firstPad : 2 * (getNumPositions() - 1 - _contacts[0].lastPad);   // Steps to the edge, two per pad
+  if (steps > room)
+    steps = room;
+  if (steps == 0)
+    return;
+
+  if(_valueMapper != nullptr) {
+    _valueMapper->move(lastStep > 0 ? steps : -steps, UPDATE_INTERVAL / 2);
+  }
+  if (lastStep > 0) {
+    countSteps(this, _swipeDownCount, steps);      // Same swipe event as the last step, not a new one
+    if(_enablePrintSwipeStatus) LOGIR("SWIPE DOWN (EXTRAPOLATED)");
+  } else {
+    countSteps(this, _swipeUpCount, steps);
+    if(_enablePrintSwipeStatus) LOGIB("SWIPE UP (EXTRAPOLATED)");
+  }
+}
+
+/**
+ * @brief Analyze the two contacts to detect pinch/spread and two-finger swipe gestures.
+ *
+ * The distance between the contacts and their center are compared to the previous two-finger scan. A change of the
+ * distance is a pinch (closer) or a spread (apart), a change of the center with the same distance is a two-finger swipe.
+ * The first scan with two fingers only stores the reference.
+ */
+void TouchSlider::analyzeTwoFingerGesture() {
+  uint8_t distance = _contacts[1].position - _contacts[0].position;
+  uint8_t center = _contacts[0].position + _contacts[1].position;
+
+  if (_twoFingerLast) {
+    if (distance < _lastContactDistance) {
+      countEvent(this, _pinchCount, METRIC_PINCH);
+      emitStroke(STROKE_PINCH);
+      if(_enablePrintSwipeStatus) LOGIY("PINCH");
+    } else if (distance > _lastContactDistance) {
+      countEvent(this, _spreadCount, METRIC_SPREAD);
+      emitStroke(STROKE_SPREAD);
+      if(_enablePrintSwipeStatus) LOGIY("SPREAD");
+    } else if (center > _lastContactCenter) {
+      countEvent(this, _twoFingerSwipeDownCount, METRIC_TWO_FINGER_SWIPES);
+      emitStroke(STROKE_TWO_FINGER_SWIPE_DOWN);
+      if(_enablePrintSwipeStatus) LOGIR("TWO FINGER SWIPE DOWN");
+    } else if (center < _lastContactCenter) {
+      countEvent(this, _twoFingerSwipeUpCount, METRIC_TWO_FINGER_SWIPES);
+      emitStroke(STROKE_TWO_FINGER_SWIPE_UP);
+      if(_enablePrintSwipeStatus) LOGIB("TWO FINGER SWIPE UP");
+    }
+  }
+  resetFirstTouches();    // Two fingers are never a swipe fine
+
+  _lastContactDistance = distance;
+  _lastContactCenter = center;
+}
+
+/**
+ * @brief Increment an event count and its metric.
+ *
+ * The count saturates at INT8_MAX, the events above it are counted as dropped because the application did not read them in time.
+ *
+ * @param self Pointer to the TouchSlider instance.
+ * @param count The event count read by the application.
+ * @param metric The metric of the event.
+ * @param steps Steps added to the count, a fast swipe covers several steps in one event.
+ */
+void TouchSlider::countEvent(TouchSlider* self, int8_t &count, TouchMetric metric, uint8_t steps) {
+  countSteps(self, count, steps);
+  self->_metrics.increment(metric);
+}
+
+/**
+ * @brief Add steps to an event count, for the steps of an event already counted in the metrics.
+ *
+ * @param self Pointer to the TouchSlider instance.
+ * @param count The event count read by the application.
+ * @param steps Steps added to the count.
+ */
+void TouchSlider::countSteps(TouchSlider* self, int8_t &count, uint8_t steps) {
+  if(count <= INT8_MAX - steps) count += steps;
+  else {
+    count = INT8_MAX;
+    self->_metrics.increment(METRIC_DROPPED_EVENTS);
+  }
+}
+
+/**
+ * @brief Report a stroke to the gesture recognizer, if one is attached.
+ * @param stroke The stroke detected on the slider.
+ */
+void TouchSlider::emitStroke(TouchStroke stroke) {
+  if(_gestureRecognizer != nullptr) {
+    _gestureRecognizer->feed(stroke);
   }
 }
 
@@ -655,12 +1691,13 @@ void TouchSlider::resetFirstTouches() {
  * This function prints the status of the touch buttons, indicating whether each button is currently touched or not.
  */
 void TouchSlider::printButtonTouched() {
-  String touchedStatus;
+  char touchedStatus[PRINT_BUFFER_SIZE] = "";
+  size_t length = 0;
   for (uint8_t i = 0; i < _numTouchButtons; i++) {
-    touchedStatus += " " + String(_ButtonTouched[i]);
+    length += snprintf(touchedStatus + length, sizeof(touchedStatus) - length, " %d", _ButtonTouched[i]);
   }
 
-  log_i("Button Touched Status: %s", touchedStatus.c_str());
+  log_i("Button Touched Status: %s", touchedStatus);
 }
 
 /**
@@ -670,12 +1707,13 @@ void TouchSlider::printButtonTouched() {
  * indicating whether each touch pad is currently touched or not.
  */
 void TouchSlider::printSliderFilteredValues() {
-  String touchedStatus;
+  char touchedStatus[PRINT_BUFFER_SIZE] = "";
+  size_t length = 0;
   for (uint8_t i = 0; i < _numSliderPins; i++) {
-    touchedStatus += " " + String(_padFilteredValue[_arraySliderPads[i]]);
+    length += snprintf(touchedStatus + length, sizeof(touchedStatus) - length, " %lu", static_cast<unsigned long>(_padFilteredValue[_arraySliderPads[i]]));
   }
 
-  log_i("Slider Touched Status (Using Pad Values): %s", touchedStatus.c_str());
+  log_i("Slider Touched Status (Using Pad Values): %s", touchedStatus);
 }
 
 /**
@@ -684,12 +1722,13 @@ void TouchSlider::printSliderFilteredValues() {
  * This function prints the status of the slider touch pads, indicating whether each touch pad is currently touched or not.
  */
 void TouchSlider::printSliderTouched() {
-  String touchedStatus;
+  char touchedStatus[PRINT_BUFFER_SIZE] = "";
+  size_t length = 0;
   for (uint8_t i = 0; i < _numSliderPins; i++) {
-    touchedStatus += " " + String(_SliderTouched[i]);
+    length += snprintf(touchedStatus + length, sizeof(touchedStatus) - length, " %d", _SliderTouched[i]);
   }
 
-  log_i("Slider Touched Status: %s", touchedStatus.c_str());
+  log_i("Slider Touched Status: %s", touchedStatus);
 }
 
 /**
@@ -701,11 +1740,12 @@ void TouchSlider::printSliderTouched() {
  * @param numSliders The number of slider values to print.
  */
 void TouchSlider::printSliderValues(uint8_t numSliders) {
-  String values;
+  char values[PRINT_BUFFER_SIZE] = "";
+  size_t length = 0;
   for (uint8_t i = 0; i < numSliders; ++i) {
-    values += " " + String(_sliderValue[i]);
+    length += snprintf(values + length, sizeof(values) - length, " %d", _sliderValue[i]);
   }
-  log_i("Slider values:%s", values.c_str());
+  log_i("Slider values:%s", values);
 }
 
 
@@ -721,42 +1761,3 @@ void TouchSlider::filter_read_cb(uint16_t *raw_value, uint16_t *filtered_value)
     }
   }
 }
-
-/**
- * @brief Map a GPIO pin to its corresponding touch pad on ESP32 or ESP8266.
- *
- * This function maps a GPIO pin to its corresponding touch pad number based on the microcontroller used.
- *
- * @param gpioPin The GPIO pin number to be mapped.
- * @return The corresponding touch pad number or TOUCH_PAD_MAX if not found.
- */
-touch_pad_t TouchSlider::mapGpioToTouchPad(gpio_num_t gpioPin) {
-#ifdef ESP32
-    if (gpioPin == GPIO_NUM_4) return TOUCH_PAD_NUM0;
-    else if (gpioPin == GPIO_NUM_0) return TOUCH_PAD_NUM1;
-    else if (gpioPin == GPIO_NUM_2) return TOUCH_PAD_NUM2;
-    else if (gpioPin == GPIO_NUM_15) return TOUCH_PAD_NUM3;
-    else if (gpioPin == GPIO_NUM_13) return TOUCH_PAD_NUM4;
-    else if (gpioPin == GPIO_NUM_12) return TOUCH_PAD_NUM5;
-    else if (gpioPin == GPIO_NUM_14) return TOUCH_PAD_NUM6;
-    else if (gpioPin == GPIO_NUM_27) return TOUCH_PAD_NUM7;
-    else if (gpioPin == GPIO_NUM_33) return TOUCH_PAD_NUM8;
-    else if (gpioPin == GPIO_NUM_32) return TOUCH_PAD_NUM9;
-#else
-    if (gpioPin == GPIO_NUM_1) return TOUCH_PAD_NUM1;
-    else if (gpioPin == GPIO_NUM_2) return TOUCH_PAD_NUM2;
-    else if (gpioPin == GPIO_NUM_3) return TOUCH_PAD_NUM3;
-    else if (gpioPin == GPIO_NUM_4) return TOUCH_PAD_NUM4;
-    else if (gpioPin == GPIO_NUM_5) return TOUCH_PAD_NUM5;
-    else if (gpioPin == GPIO_NUM_6) return TOUCH_PAD_NUM6;
-    else if (gpioPin == GPIO_NUM_7) return TOUCH_PAD_NUM7;
-    else if (gpioPin == GPIO_NUM_8) return TOUCH_PAD_NUM8;
-    else if (gpioPin == GPIO_NUM_9) return TOUCH_PAD_NUM9;
-    else if (gpioPin == GPIO_NUM_10) return TOUCH_PAD_NUM10;
-    else if (gpioPin == GPIO_NUM_11) return TOUCH_PAD_NUM11;
-    else if (gpioPin == GPIO_NUM_12) return TOUCH_PAD_NUM12;
-    else if (gpioPin == GPIO_NUM_13) return TOUCH_PAD_NUM13;
-    else if (gpioPin == GPIO_NUM_14) return TOUCH_PAD_NUM14;
-#endif
-    return TOUCH_PAD_MAX;
-}
\ No newline at end of file
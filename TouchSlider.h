@@ -10,21 +10,80 @@
 /**
 * Additional information can be found here:
 * https://docs.espressif.com/projects/esp-idf/en/latest/esp32/api-reference/peripherals/touch_pad.html
+* https://docs.espressif.com/projects/esp-idf/en/latest/esp32s3/api-reference/peripherals/touch_pad.html
 */
 /*********************** EXTERNAL LIBRARIES **********************/
 
-#include <Arduino.h>
-#include <driver/touch_pad.h>
-#include <Ticker.h>
+#ifdef ARDUINO
+  #include <Arduino.h>                // Only for the Arduino adapter (TouchSliderArduino.cpp)
+#endif
+#ifdef ESP_PLATFORM
+  #include "sdkconfig.h"              // Options of the ESP-IDF component (Kconfig)
+#endif
+#include "TouchPlatform.h"
+#include "TouchDriver.h"
+#include "TouchValueMapper.h"
+#include "TouchGestureRecognizer.h"
+#include "TouchGestureClassifier.h"
+#include "TouchSegmentDecoder.h"
+#include "TouchMetrics.h"
+#include "TouchAutoTuner.h"
 #include "Logger.h"
 
 /*********************** LIBRARY OPTIONS **********************/
-#define START_WITH_CALIBRATION                // Initialize the calibration when starting the slider, comment this line to disable
-#define START_WITH_SWIPE_FINE                 // Enable swipe fine by default, comment this line to disable
-#define START_PRINT_SWIPE_STATUS              // Print the swipe status by default, comment this line to disable
-#define START_PRINT_SLIDER_TOUCHED            // Print the slider touched by default, comment this line to disable
-// #define START_WITH_TOUCH_BUTTONS              // Enable touch buttons by default, comment this line to disable
-// #define START_PRINT_TOUCH_BUTTONS             // Enable print touch buttons by default, comment this line to disable
+#define PRINT_BUFFER_SIZE         (TOUCH_PAD_MAX * 11 + 1)   // Text of the print functions, one " 4294967295" per pad
+#define PROXIMITY_RELEASE_SCANS   4           // Scans without proximity to consider the finger away, filters the noise near the proximity threshold
+#define SWIPE_REVERSAL_STEPS      2           // Half pad steps against the last swipe needed to report a reversal, filters the noise of a finger between two pads
+
+#ifdef CONFIG_TOUCHSLIDER_KCONFIG        // ESP-IDF component, the options are set with idf.py menuconfig (see Kconfig)
+  #ifdef CONFIG_TOUCHSLIDER_START_WITH_CALIBRATION
+    #define START_WITH_CALIBRATION
+  #endif
+  #ifdef CONFIG_TOUCHSLIDER_START_WITH_SWIPE_FINE
+    #define START_WITH_SWIPE_FINE
+  #endif
+  #ifdef CONFIG_TOUCHSLIDER_START_PRINT_SWIPE_STATUS
+    #define START_PRINT_SWIPE_STATUS
+  #endif
+  #ifdef CONFIG_TOUCHSLIDER_START_PRINT_SLIDER_TOUCHED
+    #define START_PRINT_SLIDER_TOUCHED
+  #endif
+  #ifdef CONFIG_TOUCHSLIDER_START_WITH_TOUCH_BUTTONS
+    #define START_WITH_TOUCH_BUTTONS
+  #endif
+  #ifdef CONFIG_TOUCHSLIDER_START_PRINT_TOUCH_BUTTONS
+    #define START_PRINT_TOUCH_BUTTONS
+  #endif
+  #define START_UPDATE_INTERVAL   CONFIG_TOUCHSLIDER_UPDATE_INTERVAL_MS
+#else                                     // Arduino library or host build
+  #define START_WITH_CALIBRATION                // Initialize the calibration when starting the slider, comment this line to disable
+  #define START_WITH_SWIPE_FINE                 // Enable swipe fine by default, comment this line to disable
+  #define START_PRINT_SWIPE_STATUS              // Print the swipe status by default, comment this line to disable
+  #define START_PRINT_SLIDER_TOUCHED            // Print the slider touched by default, comment this line to disable
+  // #define START_WITH_TOUCH_BUTTONS              // Enable touch buttons by default, comment this line to disable
+  // #define START_PRINT_TOUCH_BUTTONS             // Enable print touch buttons by default, comment this line to disable
+  #define START_UPDATE_INTERVAL   50            // Update interval in ms to scan the touch pads
+#endif
+
+#define BASELINE_TIMEOUT_MS       200         // Longest wait for the first measurement of a pad before calibrating it
+#define TUNE_SETTLE_MS            200         // Time to wait after changing the measurement settings
+#define TUNE_SAMPLE_INTERVAL_MS   30          // Time between two readings while auto-tuning, longer than a measurement
+#define CROSSTALK_MAX_COUPLING    192         // Highest coupling between neighbour pads (Q8, 75%), higher values are not crosstalk
+#define CROSSTALK_MIN_SAMPLES     5           // Scans with a pad touched alone needed to measure its coupling
+#define CROSSTALK_MIN_PIVOT       64          // Lowest pivot of the coupling matrix (Q8, 25%), keeps the solution bounded when the coupling of a pad is close to its own signal
+
+/*********************** TYPES **********************/
+struct SliderContact {
+  uint8_t firstPad;                     // First touched pad of the contact
+  uint8_t lastPad;                      // Last touched pad of the contact
+  uint8_t position;                     // Center of the contact in half pads (firstPad + lastPad), 0 is the bottom pad
+};                                      // With a segment decoder attached, the pads are the segments of the layout
+
+struct TouchCrosstalkProfile {
+  uint8_t numPads;                      // Slider pads of the profile, 0 when the compensation is disabled
+  uint8_t fromLower[TOUCH_PAD_MAX];     // Fraction (Q8) of the delta of the previous pad seen on each slider pad
+  uint8_t fromUpper[TOUCH_PAD_MAX];     // Fraction (Q8) of the delta of the next pad seen on each slider pad
+};
 
 /*********************** CLASS DEFINITION **********************/
 
@@ -34,8 +93,8 @@ class TouchSlider
   public:
 
     // Constructors
-    TouchSlider(gpio_num_t sliderPins[], uint8_t threshold , uint8_t numSliderPins);     // Constructor with a single threshold
-    TouchSlider(gpio_num_t sliderPins[], uint8_t threshold[], uint8_t numSliderPins);   // Constructor with an array of thresholds
+    TouchSlider(const gpio_num_t sliderPins[], uint8_t threshold , uint8_t numSliderPins);   // Constructor with a single threshold
+    TouchSlider(const gpio_num_t sliderPins[], uint8_t threshold[], uint8_t numSliderPins);   // Constructor with an array of thresholds
 
     // Touch buttons functionalities
     void addTouchButton(gpio_num_t buttonPin, uint8_t thresholdPercent);            // Add a touch button to the slider, automatically enable the touch button 
@@ -45,6 +104,8 @@ class TouchSlider
     void start();                                                                       // Start the touch slider, use first addTouchButton before calling this function (with start calibration), or use calibrate_thresholds() after to add the buttons
     void stop();                                                                        // Stop the touch slider
     void resume();                                                                      // Resume the touch slider
+    void setUpdateInterval(uint16_t intervalMs);                                        // Set the interval in ms to scan the touch pads (50 ms by default)
+    uint16_t getUpdateInterval() {return UPDATE_INTERVAL;};                             // Get the interval in ms to scan the touch pads
 
     //  Enable/Disable functions
     void enableSwipeFine() {_enableSwipeFine = true;};                                  // Enable swipe fine
@@ -61,12 +122,68 @@ class TouchSlider
     void enablePrintButtonTouched() {_enablePrintBottonTouched = true;};                // Enable print array of button touched and the button that was short-pressed
     void disablePrintButtonTouched() {_enablePrintBottonTouched = false;};              // Disable print array of button touched and the button that was short-pressed
 
+    // Value mapping
+    void attachValueMapper(TouchValueMapper* valueMapper) {_valueMapper = valueMapper;};    // Map the slider motion to a value range, the mapper receives every swipe and swipe fine
+    void detachValueMapper() {_valueMapper = nullptr;};                                 // Stop mapping the slider motion
+
+    // Gesture recognition
+    void attachGestureRecognizer(TouchGestureRecognizer* gestureRecognizer) {_gestureRecognizer = gestureRecognizer;};    // Report every stroke of the slider to a multi-stroke gesture recognizer
+    void detachGestureRecognizer() {_gestureRecognizer = nullptr;};                     // Stop reporting the strokes
+    void attachGestureClassifier(TouchGestureClassifier* gestureClassifier) {_gestureClassifier = gestureClassifier;};    // Classify every touch episode with a fixed-point model
+    void detachGestureClassifier() {_gestureClassifier = nullptr;};                     // Stop classifying the touch episodes
+
+    // Interleaved electrodes
+    bool attachSegmentDecoder(TouchSegmentDecoder* segmentDecoder);                     // Decode the segments of an interleaved slider, the layout must use the slider pads as channels, disables the crosstalk compensation
+    void detachSegmentDecoder() {_segmentDecoder = nullptr;};                           // Use the slider pads as positions
+
+    // Metrics
+    TouchMetrics& getMetrics() {return _metrics;};                                      // Get the metrics registry (counters, scan jitter, pad baseline and noise)
+    typedef size_t (*MetricsWriter)(const uint8_t frame[], size_t length, void *context);  // Write a metrics frame, returns the bytes written
+    void enableMetricsWriter(MetricsWriter writer, void *context, uint16_t periodMs);   // Prepare a binary metrics frame for the writer every periodMs
+#ifdef ARDUINO
+    void enableMetricsStream(Stream &stream, uint16_t periodMs);                        // Prepare a binary metrics frame for the stream every periodMs (Arduino adapter)
+#endif
+    void disableMetricsStream() {_metricsWriter = nullptr;};                            // Stop writing metrics frames
+    bool flushMetrics();                                                                // Write the pending metrics frame, call it from the application task
+
+    // Proximity
+    typedef void (*ProximityCallback)(bool near);                                      // Called when a finger approaches the slider (true) and when it goes away (false)
+    void setProximityThreshold(uint8_t thresholdPercent);                               // Enable the proximity tier, the percentage must be higher (more sensitive) than the touch threshold, 0 disables it
+    void setProximityCallback(ProximityCallback callback) {_proximityCallback = callback;};   // Set the callback called when the proximity changes, from the slider timer
+    bool isSliderNear() {return _sliderNear;};                                          // Check if a finger is near or on the slider
+    bool getHoverStatus();                                                              // Check if a finger approached the slider without touching it since the last call
+
     // Calibration
     void calibrate_thresholds();                                                        // Calibrate the thresholds, automatically calibrate when starting the slider
 
+    // Measurement tuning
+    TouchTuneProfile autoTune(uint8_t targetSnr = 5, uint8_t samples = 32);             // Find the shortest measurement with the target SNR on every pad, call it after start() without touching the pads
+    void setTuneProfile(const TouchTuneProfile &profile);                               // Apply a measurement profile, for example one restored from flash
+    TouchTuneProfile getTuneProfile() {return _tuneProfile;};                           // Get the measurement profile applied
+
+    // Crosstalk compensation
+    void startCrosstalkCalibration();                                                   // Measure the coupling between neighbour pads, touch the center of each slider pad alone for a moment
+    bool stopCrosstalkCalibration();                                                    // Apply the coupling measured, false if some pad was not touched (its coupling is kept)
+    void setCrosstalkProfile(const TouchCrosstalkProfile &profile);                     // Apply a coupling profile, for example one restored from flash
+    TouchCrosstalkProfile getCrosstalkProfile() {return _crosstalk;};                   // Get the coupling profile applied
+    void disableCrosstalkCompensation() {_crosstalk.numPads = 0;};                      // Use the pad deltas without compensation
+
+    // Reference channel
+    void setReferencePad(gpio_num_t referencePin);                                      // Use an untouched pad to remove the common-mode drift of every pad, call it before start(), GPIO_NUM_NC removes it
+    gpio_num_t getReferencePad() {return _referencePin;};                               // Get the reference pin, GPIO_NUM_NC without reference
+    int16_t getReferenceCompensation() {return _referenceCompensation;};                // Get the common-mode compensation of the last scan, 0.01 % of the baselines (positive towards touch)
+
+    // Simulation
+    void beginSimulation(const uint32_t baseline[], uint32_t referenceBaseline = 0);    // Stop the slider and take the baselines of the slider pads from an array (one per slider pin), and of the reference pad
+    void simulateScan(const uint32_t filtered[], uint32_t referenceFiltered = 0);       // Run one scan with the filtered values of the slider pads from an array (one per slider pin), and of the reference pad
+    void endSimulation() {_simulating = false;};                                        // Leave the simulation, call start() to scan the touch pads again
+
     // Getters
     int8_t getSwipeStatus();                                                            // Get the swipe status
     int8_t getSwipeStatusFine();                                                        // Get the swipe fine status
+    int8_t getPinchStatus();                                                            // Get the two-finger pinch/spread status
+    int8_t getTwoFingerSwipeStatus();                                                   // Get the two-finger swipe status
+    uint8_t getContacts(SliderContact contacts[], uint8_t maxContacts);                 // Get the contacts (fingers) on the slider
     gpio_num_t getButtonShortPress();                                                   // Get the button short press 
     bool getSliderRunning() {return _sliderRunning;};                                   // Get the slider running status
     bool isTouchButtonPressed(gpio_num_t buttonPin);                                    // Check if a touch button is pressed
@@ -79,37 +196,93 @@ class TouchSlider
     bool _sliderRunning = false;                                      // Indicates whether the timer is running
     uint8_t TOUCH_THRESHOLD = 0;                                      // (0-100) Higher percentage means more sensitive
     uint8_t TOUCH_THRESHOLD_ARRAY[TOUCH_PAD_MAX];                     // (0-100) Higher percentage means more sensitive
-    uint16_t threshold_inactive = 0;                                  // Threshold for inactive touch
     uint8_t filter_period = 10;                                       // Filter period in ms
 
     // Enums
     enum { NO_CHANGE, SWIPE_UP, SWIPE_DOWN};                          // Swipe status
 
     // Timers
-    Ticker sliderTicker;                                              // Timer for updating the touch pads
-    const uint16_t UPDATE_INTERVAL = 50;                              // Update interval in ms to scan the touch pads
+    TouchTimer sliderTicker;                                          // Timer for updating the touch pads
+    uint16_t UPDATE_INTERVAL = START_UPDATE_INTERVAL;                 // Update interval in ms to scan the touch pads
 
     // Static configuration and runtime state
     static uint8_t _padThresholdPercent[TOUCH_PAD_MAX];               // (0-100) Higher percentage means more sensitive
     static bool _padEnabled[TOUCH_PAD_MAX];                           // Indicates whether the touch pad is enabled
-    static uint16_t _padFilteredValue[TOUCH_PAD_MAX];                 // Filtered value of the touch pad
-    static uint16_t _padThreshold[TOUCH_PAD_MAX];                     // Threshold for touch pad
+    static uint32_t _padFilteredValue[TOUCH_PAD_MAX];                 // Filtered value of the touch pad
+    static uint32_t _padBaseline[TOUCH_PAD_MAX];                      // Untouched value of the touch pad (v1: calibration reading, v2: hardware benchmark)
+    static uint32_t _padThreshold[TOUCH_PAD_MAX];                     // Threshold for touch pad, as a change from the baseline
+    static uint32_t _padProximityThreshold[TOUCH_PAD_MAX];            // Proximity threshold for touch pad, as a change from the baseline
+    static uint32_t _padDelta[TOUCH_PAD_MAX];                         // Signal of the touch pad in the touch direction, compensated, refreshed on every scan
     int16_t _lastValue, _actualValue;                                 // Last and actual value of the touch pad
     uint8_t _sliderState = NO_CHANGE;                                 // Swipe status in last update
 
     uint8_t _numSliderPins = 0;                                       // Number of slider pins
     gpio_num_t _arraySliderPins[TOUCH_PAD_MAX];                          // Array of slider pins
     touch_pad_t _arraySliderPads[TOUCH_PAD_MAX];                          // Array of slider pads
-    bool _SliderTouched[TOUCH_PAD_MAX];                               // Indicates whether the slider is touched
+    bool _SliderTouched[TOUCH_PAD_MAX] = {};                         // Indicates whether the slider is touched
     static int8_t _sliderValue[TOUCH_PAD_MAX];                       // Value of the slider
 
     int8_t _swipeCount = 0;                                           // Swipe count
+    int8_t _lastSwipeStep = 0;                                        // Swipe count of the last scan, 0 if the finger did not move
+    int8_t _swipeDirection = 0;                                       // Sign of the last swipe of the touch, 0 before the first one
+    uint16_t _lastSwipeScans = 0;                                     // Scans taken by the last swipe step, to extrapolate its speed
     int8_t _swipeUpCount = 0;                                         // Swipe up count
     int8_t _swipeDownCount = 0;                                       // Swipe down count
     
     int8_t _swipeFineUpCount = 0;                                     // Swipe fine up count
     int8_t _swipeFineDownCount = 0;                                   // Swipe fine down count
 
+    SliderContact _contacts[2];                                       // Contacts (fingers) found on the last scan, sorted from bottom to top
+    uint8_t _numContacts = 0;                                         // Number of contacts found on the last scan
+    bool _twoFingerLast = false;                                      // Indicates whether the last scan had two contacts
+    uint8_t _lastContactDistance = 0;                                 // Distance between the two contacts on the last scan, in half pads
+    uint8_t _lastContactCenter = 0;                                   // Sum of the positions of the two contacts on the last scan, in half pads
+    int8_t _pinchCount = 0;                                           // Pinch count
+    int8_t _spreadCount = 0;                                          // Spread count
+    int8_t _twoFingerSwipeUpCount = 0;                                // Two-finger swipe up count
+    int8_t _twoFingerSwipeDownCount = 0;                              // Two-finger swipe down count
+
+    TouchValueMapper* _valueMapper = nullptr;                         // Value mapper attached to the slider
+    TouchGestureRecognizer* _gestureRecognizer = nullptr;             // Gesture recognizer attached to the slider
+    TouchGestureClassifier* _gestureClassifier = nullptr;             // Gesture classifier attached to the slider
+    TouchSegmentDecoder* _segmentDecoder = nullptr;                   // Segment decoder of an interleaved slider
+    uint16_t _scansSinceMove = 0;                                     // Scan intervals touched since the first touch or the last swipe, to measure the swipe speed
+
+    TouchMetrics _metrics;                                            // Metrics registry
+    MetricsWriter _metricsWriter = nullptr;                           // Writer of the metrics frames
+    void *_metricsContext = nullptr;                                  // Context of the metrics writer, for example a stream
+    uint16_t _metricsPeriodScans = 0;                                 // Scans between two metrics frames
+    uint16_t _scansSinceFrame = 0;                                    // Scans since the last metrics frame
+    enum { METRICS_FRAME_EMPTY, METRICS_FRAME_READY, METRICS_FRAME_FAILED };   // State of the pending metrics frame
+    uint8_t _metricsFrame[METRICS_FRAME_MAX_SIZE];                    // Metrics frame prepared by the scan, written by flushMetrics()
+    size_t _metricsFrameLength = 0;                                   // Bytes of the pending metrics frame
+    volatile uint8_t _metricsFrameState = METRICS_FRAME_EMPTY;        // The scan fills an empty frame, flushMetrics() writes a ready one
+    int64_t _lastScanTimeUs = 0;                                      // Time of the last scan, to measure the scan jitter
+    uint16_t _touchScans = 0;                                         // Scans of the current touch episode
+
+    TouchTuneProfile _tuneProfile = {false, 0, 0, 0};                 // Measurement profile applied, not valid while the driver defaults are used
+
+    // Crosstalk compensation
+    TouchCrosstalkProfile _crosstalk = {};                            // Coupling between neighbour slider pads
+    bool _crosstalkCalibrating = false;                               // Indicates whether the coupling is being measured
+    uint16_t _crosstalkMinLower[TOUCH_PAD_MAX];                       // Lowest coupling from the previous pad seen while calibrating (Q8)
+    uint16_t _crosstalkMinUpper[TOUCH_PAD_MAX];                       // Lowest coupling from the next pad seen while calibrating (Q8)
+    uint8_t _crosstalkSamples[TOUCH_PAD_MAX];                         // Scans with each slider pad touched alone while calibrating
+    int32_t _crosstalkPivot[TOUCH_PAD_MAX];                           // Pivot of each row of the factored coupling matrix (Q16)
+    int32_t _crosstalkUpper[TOUCH_PAD_MAX];                           // Coupling from the next pad divided by the pivot of the row (Q16)
+    bool _simulating = false;                                         // Indicates whether the pad values are injected by simulateScan()
+
+    // Reference channel
+    gpio_num_t _referencePin = GPIO_NUM_NC;                           // Pin of the reference pad
+    touch_pad_t _referencePad = TOUCH_PAD_MAX;                        // Reference pad, TOUCH_PAD_MAX without reference
+    int16_t _referenceCompensation = 0;                               // Common-mode compensation of the last scan (0.01 % of the baselines)
+
+    uint8_t _proximityPercent = 0;                                    // (0-100) Proximity threshold of the slider pads, 0 when disabled
+    bool _sliderNear = false;                                         // Indicates whether a finger is near or on the slider
+    bool _hoverDetected = false;                                      // Indicates whether a finger approached without touching, until it is read
+    uint8_t _scansAway = 0;                                           // Scans without proximity since the finger was near
+    ProximityCallback _proximityCallback = nullptr;                   // Callback called when the proximity changes
+
     bool firstTouch = true;                                           // Indicates whether the first touch is detected
     bool firstPadTop = false;                                         // Indicates whether the first pad is touched
     bool firstPadBot = false;                                         // Indicates whether the last pad is touched
@@ -123,7 +296,7 @@ class TouchSlider
     gpio_num_t _arrayButtonPins[TOUCH_PAD_MAX];                       // Array of button pins
     touch_pad_t _arrayButtonPads[TOUCH_PAD_MAX];                      // Array of button pads
     uint8_t _buttonThresholdPercent[TOUCH_PAD_MAX];                   // (0-100) Higher percentage means more sensitive
-    bool _ButtonTouched[TOUCH_PAD_MAX];                               // Indicates whether the button is touched
+    bool _ButtonTouched[TOUCH_PAD_MAX] = {};                         // Indicates whether the button is touched
     uint8_t TOUCH_BUTTON_MAX = TOUCH_PAD_MAX;                         // Maximum number of touch buttons
     uint8_t _numTouchButtons = 0;                                     // Number of touch buttons
     gpio_num_t _gpioButtonTouched = GPIO_NUM_NC;                     // Index of the touched button
@@ -133,15 +306,34 @@ class TouchSlider
     void setDefaultConfiguration();                                                   // Set the configuration
     void begin();                                                                     // Initialize the touch slider
     static void update(TouchSlider* self);                                            // Update the touch slider  
+    static void timerCallback(void *arg);                                             // Scan timer callback, calls update
   
     static void filter_read_cb(uint16_t *raw_value, uint16_t *filtered_value);        // Callback function for filtering the touch pads *Filter output reading hook, see ESP-IDF file touch_pad.h for more information
     void printSliderTouched();                                                        // Print the slider touched
     void printButtonTouched();                                                        // Print the button touched
     void analyzeGesture(uint8_t numSliders);                                          // Analyze the gesture
-    touch_pad_t mapGpioToTouchPad(gpio_num_t gpioPin);                                // Map the GPIO pin to the touch pad
+    void extrapolateSwipe();                                                          // Add the movement of a fast swipe between the last scan and the release
+    static void updatePadDeltas(TouchSlider* self);                                   // Refresh the pad deltas, compensate the common-mode drift and the crosstalk of the slider pads
+    static void compensateCommonMode(TouchSlider* self);                              // Remove the movement of the reference pad from the deltas of the other pads
+    static void measureCrosstalk(TouchSlider* self);                                  // Measure the coupling of the pad touched alone
+    static void decoupleSliderPads(TouchSlider* self);                                // Remove the crosstalk from the deltas of the slider pads
+    void factorCrosstalk();                                                           // Factor the coupling matrix of the crosstalk profile
+    void feedClassifier(uint8_t numContacts);                                         // Report a touched scan to the gesture classifier
+    static bool decodeSegments(TouchSlider* self, int8_t& firstTouchedIndex, int8_t& lastTouchedIndex, uint8_t& touchedPadCount);   // Resolve the touched segments of an interleaved slider
+    uint8_t getNumPositions();                                                        // Get the pads of the slider, or the segments with a segment decoder
+    void analyzeTwoFingerGesture();                                                   // Analyze the pinch/spread and two-finger swipe gestures
+    static uint8_t segmentContacts(TouchSlider* self);                                // Split the touched pads in contiguous runs (contacts)
+    static void countEvent(TouchSlider* self, int8_t &count, TouchMetric metric, uint8_t steps = 1);   // Increment an event count, saturated, and its metric
+    static void countSteps(TouchSlider* self, int8_t &count, uint8_t steps);          // Add steps to an event count, saturated, without a new event
     void printSliderValues(uint8_t numSliders);                                       // Print the slider values
     void printSliderFilteredValues();                                                 // Print the slider filtered values
 
+    static void readPadValues();                                                      // Read the filtered values and baselines when the backend has no read callback
+    static bool isPadTouched(touch_pad_t pad);                                        // Check if a touch pad is touched based on the filtered value and threshold
+    static void recordPadMetrics(TouchSlider* self);                                  // Record the baseline, filtered value and noise of the enabled pads
+    static void streamMetrics(TouchSlider* self);                                     // Prepare a metrics frame when the period has elapsed
+    static void checkProximity(TouchSlider* self, bool padTouchedFound);             // Check if a finger is near the slider pads
+    void calculateProximityThresholds();                                              // Calculate the proximity thresholds from the baselines
     static void checkButtonStatus(TouchSlider* self);                                 // Check the button status
     static void checkSingleButtonTouch(TouchSlider* self);                            // Check the single button touch
     static void checkSliderStatus(TouchSlider* self, bool &padTouchedFound, int8_t &firstTouchedIndex,
@@ -152,6 +344,7 @@ class TouchSlider
     static uint8_t getIndexFromGpioSlider(TouchSlider* self, gpio_num_t gpioPin);                              // Get the index from the GPIO pin on the slider array
     static uint8_t getIndexFromGpioButton(TouchSlider* self, gpio_num_t gpioPin);                              // Get the index from the GPIO pin on the button array
     
+    void emitStroke(TouchStroke stroke);                                              // Report a stroke to the gesture recognizer
     void resetFirstTouches();                                                         // Reset the first touches
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,40 @@
+/*
+* Marcos Abraham Carballo Vazquez
+* Original Creation Date: Dicember 5, 2024
+* https://github.com/MarcosCarballoV/TouchSlider_ESP32
+* */
+
+/**
+* Arduino adapter of the library, only the functions that need the Arduino core live here. The rest of the library
+* builds as an ESP-IDF component or on a host computer (see CMakeLists.txt).
+*/
+#ifdef ARDUINO
+#include "TouchSlider.h"
+
+/*********************** LOCAL FUNCTIONS **********************/
+/**
+ * @brief Metrics writer for an Arduino Stream.
+ * @param frame The frame.
+ * @param length Bytes of the frame.
+ * @param context Pointer to the Stream.
+ * @return The bytes written.
+ */
+static size_t writeMetricsToStream(const uint8_t frame[], size_t length, void *context) {
+  return static_cast<Stream*>(context)->write(frame, length);
+}
+
+/*********************** PUBLIC FUNCTIONS **********************/
+/**
+ * @brief Write a binary metrics frame to a stream periodically.
+ *
+ * The frame is prepared by the slider timer and written by flushMetrics(), call it from loop(). See TouchMetrics.h for
+ * its layout and TouchMetrics::decodeFrame() to decode it.
+ *
+ * @param stream The stream for the frames, for example Serial.
+ * @param periodMs Time between two frames in ms, rounded to the scan interval.
+ */
+void TouchSlider::enableMetricsStream(Stream &stream, uint16_t periodMs)
+{
+  enableMetricsWriter(writeMetricsToStream, &stream, periodMs);
+}
+#endif
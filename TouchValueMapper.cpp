@@ -0,0 +1,256 @@
+#include "TouchValueMapper.h"
+
+/*********************** CONSTRUCTORS **********************/
+/**
+ * @brief Constructor for TouchValueMapper class
+ *
+ * This constructor initializes a TouchValueMapper with a value range, the value starts clamped to that range.
+ * Without a ballistic curve every pad moves the value one unit.
+ *
+ * @param minValue The minimum value of the range.
+ * @param maxValue The maximum value of the range.
+ * @param initialValue The initial value.
+ **/
+TouchValueMapper::TouchValueMapper(int32_t minValue, int32_t maxValue, int32_t initialValue) {
+  if (minValue > maxValue) {    // Accept the limits in any order
+    int32_t temp = minValue;
+    minValue = maxValue;
+    maxValue = temp;
+  }
+  _minValue = minValue;
+  _maxValue = maxValue;
+  _value = limitValue(initialValue);
+}
+
+/*********************** PUBLIC FUNCTIONS **********************/
+/**
+ * @brief Set the ballistic curve.
+ *
+ * The gain between two points is linearly interpolated, below the first point the first gain is used and above the last
+ * point the last gain is used.
+ *
+ * @param curve Array of points (speed in pads per second, gain in Q8 value units per pad).
+ * @param numPoints Number of points, limited to VALUE_MAPPER_MAX_CURVE_POINTS.
+ */
+void TouchValueMapper::setCurve(const BallisticPoint curve[], uint8_t numPoints) {
+  if (numPoints > VALUE_MAPPER_MAX_CURVE_POINTS)
+    numPoints = VALUE_MAPPER_MAX_CURVE_POINTS;
+
+  for (uint8_t i = 0; i < numPoints; ++i) {   // Insert each point sorted by speed
+    uint8_t j = i;
+    while (j > 0 && _curve[j - 1].speed > curve[i].speed) {
+      _curve[j] = _curve[j - 1];
+      --j;
+    }
+    _curve[j] = curve[i];
+  }
+  _numCurvePoints = numPoints;
+}
+
+/**
+ * @brief Set the detents.
+ *
+ * When a movement slower than maxSpeed crosses a detent, the value stops on it and the next holdUnits of motion are absorbed
+ * before the value leaves it. Faster movements go through the detents, so large adjustments are not interrupted.
+ *
+ * @param detents Array of detent values.
+ * @param numDetents Number of detents, limited to VALUE_MAPPER_MAX_DETENTS. Use 0 to remove the detents.
+ * @param holdUnits Motion in value units absorbed on a detent.
+ * @param maxSpeed Maximum speed (pads per second) captured by the detents.
+ */
+void TouchValueMapper::setDetents(const int32_t detents[], uint8_t numDetents, uint16_t holdUnits, uint16_t maxSpeed) {
+  if (numDetents > VALUE_MAPPER_MAX_DETENTS)
+    numDetents = VALUE_MAPPER_MAX_DETENTS;
+
+  for (uint8_t i = 0; i < numDetents; ++i) {  // Insert each detent sorted by value
+    uint8_t j = i;
+    while (j > 0 && _detents[j - 1] > detents[i]) {
+      _detents[j] = _detents[j - 1];
+      --j;
+    }
+    _detents[j] = detents[i];
+  }
+  _numDetents = numDetents;
+  _detentHoldUnits = holdUnits;
+  _detentMaxSpeed = maxSpeed;
+  _detentHold = 0;
+}
+
+/**
+ * @brief Apply a movement of the finger.
+ *
+ * The speed of the movement selects the gain of the ballistic curve. The fraction of a value unit that can not be applied
+ * yet is kept for the next movement in the same direction, so slow motion still moves the value with small gains, and
+ * two half pad steps move the value as much as one pad.
+ *
+ * @param steps Steps moved, VALUE_MAPPER_STEPS_PER_PAD per pad (the swipe steps of the slider), positive values are
+ *              swipe-down movements.
+ * @param elapsedMs Time taken by the movement in ms, 0 is treated as the fastest speed.
+ * @return The mapped value after the movement.
+ */
+int32_t TouchValueMapper::move(int16_t steps, uint16_t elapsedMs) {
+  if (steps == 0)
+    return _value;
+  if (_inverted)
+    steps = -steps;
+
+  uint32_t absSteps = steps < 0 ? -steps : steps;
+  uint32_t speed = elapsedMs == 0 ? UINT16_MAX : absSteps * 1000 / (static_cast<uint32_t>(elapsedMs) * VALUE_MAPPER_STEPS_PER_PAD);   // Pads per second
+  if (speed > UINT16_MAX)
+    speed = UINT16_MAX;
+
+  if ((steps > 0 && _remainder < 0) || (steps < 0 && _remainder > 0))
+    _remainder = 0;   // A change of direction drops the pending fraction
+
+  const int32_t unit = VALUE_MAPPER_GAIN_ONE * VALUE_MAPPER_STEPS_PER_PAD;   // One value unit, the gains are per pad
+  int64_t scaled = static_cast<int64_t>(steps) * getGainForSpeed(speed) + _remainder;
+  int32_t delta = scaled / unit;
+  _remainder = scaled - static_cast<int64_t>(delta) * unit;
+
+  applyDelta(delta, speed);
+  return _value;
+}
+
+/**
+ * @brief Apply swipe fine steps.
+ *
+ * Each step moves the value by the fine step, without ballistics and leaving any detent.
+ *
+ * @param steps Swipe fine steps, positive values are swipe fine down.
+ * @return The mapped value after the steps.
+ */
+int32_t TouchValueMapper::nudge(int8_t steps) {
+  if (_inverted)
+    steps = -steps;
+
+  _detentHold = 0;
+  storeValue(limitValue(_value + static_cast<int32_t>(steps) * _fineStep));
+  return _value;
+}
+
+/**
+ * @brief The finger left the slider, the pending fraction of a value unit is dropped.
+ */
+void TouchValueMapper::release() {
+  _remainder = 0;
+}
+
+/**
+ * @brief Set the mapped value.
+ *
+ * The value is limited to the range. It is not reported as a change and the callback is not called.
+ *
+ * @param value The new value.
+ */
+void TouchValueMapper::setValue(int32_t value) {
+  _value = limitValue(value);
+  _remainder = 0;
+  _detentHold = 0;
+}
+
+/**
+ * @brief Check if the value changed since the last call and reset the flag.
+ * @retval true: The value changed
+ */
+bool TouchValueMapper::isValueChanged() {
+  bool changed = _changed;
+  _changed = false;
+  return changed;
+}
+
+/**
+ * @brief Get the gain of the ballistic curve for a speed.
+ * @param speed Speed in pads per second.
+ * @return The gain in Q8 value units per pad.
+ */
+uint32_t TouchValueMapper::getGainForSpeed(uint16_t speed) {
+  if (_numCurvePoints == 0)
+    return VALUE_MAPPER_GAIN_ONE;
+  if (speed <= _curve[0].speed)
+    return _curve[0].gain;
+
+  for (uint8_t i = 1; i < _numCurvePoints; ++i) {
+    if (speed <= _curve[i].speed) {   // Linear interpolation between the two points around the speed
+      const BallisticPoint &low = _curve[i - 1];
+      const BallisticPoint &high = _curve[i];
+      int64_t gainSpan = static_cast<int64_t>(high.gain) - low.gain;
+      return low.gain + gainSpan * (speed - low.speed) / (high.speed - low.speed);
+    }
+  }
+  return _curve[_numCurvePoints - 1].gain;
+}
+
+/*********************** PRIVATE FUNCTIONS **********************/
+/**
+ * @brief Apply a change of the value.
+ *
+ * The hold of the current detent absorbs the motion first. Then, if the movement is slow enough, it stops on the first
+ * detent crossed. At the end the value is clamped or wrapped to the range.
+ *
+ * @param delta Change of the value in value units.
+ * @param speed Speed of the movement in pads per second.
+ */
+void TouchValueMapper::applyDelta(int32_t delta, uint16_t speed) {
+  if (delta == 0)
+    return;
+
+  int32_t direction = delta > 0 ? 1 : -1;
+  if (_detentHold > 0) {    // Absorb the motion while the value is held on a detent
+    uint32_t absDelta = delta * direction;
+    if (absDelta <= _detentHold) {
+      _detentHold -= absDelta;
+      return;
+    }
+    delta -= direction * _detentHold;
+    _detentHold = 0;
+  }
+
+  int32_t target = _value + delta;
+  if (_numDetents > 0 && speed <= _detentMaxSpeed) {   // Stop on the first detent crossed by a slow movement
+    for (uint8_t i = 0; i < _numDetents; ++i) {
+      int32_t detent = direction > 0 ? _detents[i] : _detents[_numDetents - 1 - i];
+      bool crossed = direction > 0 ? (detent > _value && detent <= target) : (detent < _value && detent >= target);
+      if (crossed) {
+        target = detent;
+        _detentHold = _detentHoldUnits;
+        _remainder = 0;
+        break;
+      }
+    }
+  }
+
+  storeValue(limitValue(target));
+}
+
+/**
+ * @brief Store a new value, flag the change and call the callback.
+ * @param value The new value, already limited to the range.
+ */
+void TouchValueMapper::storeValue(int32_t value) {
+  if (value == _value)
+    return;
+
+  _value = value;
+  _changed = true;
+  if (_callback != nullptr)
+    _callback(_value);
+}
+
+/**
+ * @brief Clamp or wrap a value to the range.
+ * @param value The value to limit.
+ * @return The value inside the range.
+ */
+int32_t TouchValueMapper::limitValue(int32_t value) {
+  if (_clamp) {
+    if (value < _minValue) return _minValue;
+    if (value > _maxValue) return _maxValue;
+    return value;
+  }
+
+  int64_t range = static_cast<int64_t>(_maxValue) - _minValue + 1;
+  int64_t offset = (static_cast<int64_t>(value) - _minValue) % range;
+  if (offset < 0)
+    offset += range;
+  return static_cast<int32_t>(_minValue + offset);
+}
@@ -0,0 +1,89 @@
+/*
+* Marcos Abraham Carballo Vazquez
+* Original Creation Date: Dicember 5, 2024
+* https://github.com/MarcosCarballoV/TouchSlider_ESP32
+* */
+
+#ifndef TOUCHVALUEMAPPER_H
+#define TOUCHVALUEMAPPER_H
+
+/**
+* Maps the slider motion to an application value range (for example 0-255 brightness or 0-100 volume).
+*
+* Each movement reported by the slider is converted with a ballistic curve: the speed of the finger (pads per second)
+* selects the gain (value units per pad), so slow motion gives fine steps and fast motion gives coarse steps.
+* The slider reports its movement in steps of half a pad (VALUE_MAPPER_STEPS_PER_PAD), the mapper converts them to pads.
+* With a segment decoder attached, a pad is a segment.
+* Optional detents hold the value on selected points, and the value is clamped (or wrapped) to the range.
+* Attach it to a TouchSlider with attachValueMapper() and read the final value with getValue().
+*/
+/*********************** EXTERNAL LIBRARIES **********************/
+
+#include <stdint.h>
+
+/*********************** LIBRARY OPTIONS **********************/
+#define VALUE_MAPPER_MAX_CURVE_POINTS   8     // Maximum number of points of the ballistic curve
+#define VALUE_MAPPER_MAX_DETENTS        8     // Maximum number of detents
+#define VALUE_MAPPER_GAIN_ONE           256   // Gain of one value unit per pad (gains are fixed-point Q8)
+#define VALUE_MAPPER_STEPS_PER_PAD      2     // Steps of the slider per pad, the finger also stops between two pads
+
+/*********************** CLASS DEFINITION **********************/
+
+class TouchValueMapper
+{
+  public:
+    struct BallisticPoint {
+      uint16_t speed;                                                 // Finger speed in pads per second
+      uint32_t gain;                                                  // Value units per pad at this speed (Q8, VALUE_MAPPER_GAIN_ONE = 1 unit)
+    };
+    typedef void (*ValueCallback)(int32_t value);                     // Called with the new value every time it changes
+
+    // Constructor
+    TouchValueMapper(int32_t minValue, int32_t maxValue, int32_t initialValue);       // Constructor with the value range and the initial value
+
+    // Configuration
+    void setCurve(const BallisticPoint curve[], uint8_t numPoints);                   // Set the ballistic curve, points sorted by speed
+    void setDetents(const int32_t detents[], uint8_t numDetents, uint16_t holdUnits, uint16_t maxSpeed);   // Set the detents, their hold and the maximum speed they capture
+    void setFineStep(uint16_t fineStep) {_fineStep = fineStep;};                      // Set the value units moved by a swipe fine
+    void setCallback(ValueCallback callback) {_callback = callback;};                 // Set the callback called when the value changes
+    void enableClamping() {_clamp = true;};                                           // Clamp the value to the range (default)
+    void disableClamping() {_clamp = false;};                                         // Wrap the value around the range
+    void enableInverted() {_inverted = true;};                                        // Swipe up increases the value
+    void disableInverted() {_inverted = false;};                                      // Swipe down increases the value (default)
+
+    // Motion input, called by TouchSlider
+    int32_t move(int16_t steps, uint16_t elapsedMs);                                  // Apply a movement of some steps (half pads) done in elapsedMs
+    int32_t nudge(int8_t steps);                                                      // Apply swipe fine steps, without ballistics
+    void release();                                                                   // The finger left the slider
+
+    // Getters/Setters
+    int32_t getValue() {return _value;};                                              // Get the mapped value
+    void setValue(int32_t value);                                                     // Set the mapped value, limited to the range
+    bool isValueChanged();                                                            // Check if the value changed since the last call
+    uint32_t getGainForSpeed(uint16_t speed);                                         // Get the gain of the ballistic curve for a speed
+
+  private:
+    int32_t _minValue;                                                // Minimum value of the range
+    int32_t _maxValue;                                                // Maximum value of the range
+    int32_t _value;                                                   // Mapped value
+    int32_t _remainder = 0;                                           // Fraction of a value unit not applied yet (Q8 / VALUE_MAPPER_STEPS_PER_PAD)
+    bool _changed = false;                                            // Indicates whether the value changed since the last check
+    bool _clamp = true;                                               // Indicates whether to clamp (true) or wrap (false) the value
+    bool _inverted = false;                                           // Indicates whether the direction is inverted
+    uint16_t _fineStep = 1;                                           // Value units moved by a swipe fine
+    ValueCallback _callback = nullptr;                                // Callback called when the value changes
+
+    BallisticPoint _curve[VALUE_MAPPER_MAX_CURVE_POINTS];             // Ballistic curve
+    uint8_t _numCurvePoints = 0;                                      // Number of points of the ballistic curve
+
+    int32_t _detents[VALUE_MAPPER_MAX_DETENTS];                       // Detent values, sorted
+    uint8_t _numDetents = 0;                                          // Number of detents
+    uint16_t _detentHoldUnits = 0;                                    // Motion (value units) absorbed before leaving a detent
+    uint16_t _detentMaxSpeed = 0;                                     // Detents only capture movements up to this speed (pads per second)
+    uint16_t _detentHold = 0;                                         // Motion left to absorb on the current detent
+
+    void applyDelta(int32_t delta, uint16_t speed);                                   // Apply a change of the value with detents and limits
+    void storeValue(int32_t value);                                                   // Store a new value and notify the change
+    int32_t limitValue(int32_t value);                                                // Clamp or wrap the value to the range
+};
+#endif
@@ -0,0 +1,68 @@
+#include <Arduino.h>              // Arduino library
+#include "Logger.h"               // Logger library
+#include "TouchSlider.h"          // TouchSlider library
+#include "TouchValueMapper.h"     // Value mapper library
+
+// Pins designed for sliders, edit according to your setup
+#define THRESHOLD_SLIDER  75              // Threshold slider on percentage
+#define SLIDER1_PIN     GPIO_NUM_33
+#define SLIDER2_PIN     GPIO_NUM_27
+#define SLIDER3_PIN     GPIO_NUM_14
+#define SLIDER4_PIN     GPIO_NUM_4
+
+gpio_num_t arraySlidersPins[] = {         // Array of slider pins
+  SLIDER1_PIN,
+  SLIDER2_PIN,
+  SLIDER3_PIN,
+  SLIDER4_PIN
+};
+
+// Define the limits for the brightness values.
+#define MIN_VALUE  0
+#define MAX_VALUE  255
+#define DEFAULT_BRIGHTNESS_VALUE 128
+
+size_t numSlidersPins = sizeof(arraySlidersPins) / sizeof(arraySlidersPins[0]);   // Number of sliders
+TouchSlider touchSlider(arraySlidersPins, THRESHOLD_SLIDER, numSlidersPins);      // TouchSlider object
+TouchValueMapper brightness(MIN_VALUE, MAX_VALUE, DEFAULT_BRIGHTNESS_VALUE);      // Brightness mapped from the slider motion
+
+// Ballistic curve: speed in pads per second, gain in value units per pad (VALUE_MAPPER_GAIN_ONE = 1 unit)
+// The mapper converts the half pad steps of the slider, so a swipe over one pad moves 1, 8 or 48 units
+const TouchValueMapper::BallisticPoint brightnessCurve[] = {
+  {5,  VALUE_MAPPER_GAIN_ONE},            // Slow motion: 1 unit per pad
+  {20, 8 * VALUE_MAPPER_GAIN_ONE},        // Medium motion: 8 units per pad
+  {60, 48 * VALUE_MAPPER_GAIN_ONE}        // Fast motion: 48 units per pad, a quick stroke covers the whole range
+};
+const int32_t brightnessDetents[] = {MAX_VALUE / 2};     // Stop on half brightness when moving slowly
+
+void brightnessChanged(int32_t value) {   // Called from the slider timer every time the value changes
+  Serial.printf("Actual brightness: %d\n", value);
+}
+
+void setup() {
+  Serial.begin(115200);                     // Begin serial communication
+
+  brightness.setCurve(brightnessCurve, sizeof(brightnessCurve) / sizeof(brightnessCurve[0]));
+  brightness.setDetents(brightnessDetents, 1, 4, 20);   // Hold 4 units on the detent, only for movements up to 20 pads per second
+  brightness.setFineStep(1);                            // A swipe fine moves the brightness 1 unit
+  brightness.setCallback(brightnessChanged);
+
+  touchSlider.enableSwipeFine();            // Enable swipe fine
+  touchSlider.disableTouchButtons();        // Disable touch buttons
+  touchSlider.disablePrintSliderTouched();  // Disable print slider touched
+  touchSlider.disablePrintSwipeStatus();    // Disable print swipe status
+  touchSlider.attachValueMapper(&brightness);   // The slider moves the brightness directly, no per-step loop is needed
+
+  touchSlider.start();                          // Start touch slider
+  Serial.println("TouchSlider initialized");    // Logging
+}
+
+void loop() {
+  delay(200);   // Delay for 200ms
+
+  // Rest of the code, use brightness.getValue() to read the actual brightness
+  /*
+  ...
+  ...
+  */
+}
@@ -0,0 +1,110 @@
+#include "TouchAutoTuner.h"
+#include "TouchTuneModel.h"
+#include "TouchTest.h"
+
+// Search of TouchAutoTuner on synthetic electrodes whose noise falls with the measurement cycles.
+
+#define NUM_PADS          4
+#define BASELINE          2000            // Threshold delta of 400 counts with a threshold percentage of 80
+#define REFERENCE_CYCLES  100
+
+static const uint8_t voltages[] = {0, 1, 2};
+static const uint8_t voltageNoise[] = {150, 100, 60};                 // Noise of each voltage range (%)
+static const uint16_t measCycles[] = {800, 25, 200, 50, 400, 100};    // Sorted by the tuner
+static const uint16_t padNoise[] = {40, 60, 80, 50};                  // Pad 2 decides the SNR
+
+static void setupModel(TouchTuneModel &model) {
+  for (uint8_t i = 0; i < NUM_PADS; ++i) {
+    model.setPadNoise(i, padNoise[i]);
+  }
+  for (uint8_t i = 0; i < sizeof(voltages); ++i) {
+    model.setVoltageNoise(voltages[i], voltageNoise[i]);
+  }
+}
+
+/**
+ * @brief Measure every setting and find the expected profile.
+ * @param tuner The tuner, used to measure the settings.
+ * @param model The model.
+ * @param targetSnr Target SNR (Q4).
+ * @return The shortest setting meeting the target (highest SNR on a tie), or the one with the highest SNR.
+ */
+static TouchTuneProfile bruteForce(TouchAutoTuner &tuner, TouchTuneModel &model, uint16_t targetSnr) {
+  TouchTuneProfile best = {false, 0, 0, 0};
+  for (uint8_t v = 0; v < sizeof(voltages); ++v) {
+    for (uint8_t c = 0; c < sizeof(measCycles) / sizeof(measCycles[0]); ++c) {
+      TouchTuneSetting setting = {voltages[v], measCycles[c]};
+      uint16_t snr = tuner.measure(model, setting);
+      bool valid = snr >= targetSnr;
+      bool better;
+      if (valid != best.valid)
+        better = valid;
+      else if (valid && setting.measCycles != best.measCycles)
+        better = setting.measCycles < best.measCycles;
+      else
+        better = snr > best.snr;
+      if (better)
+        best = {valid, setting.voltage, setting.measCycles, snr};
+    }
+  }
+  return best;
+}
+
+static void testModel() {
+  TouchTuneModel model(NUM_PADS, BASELINE, 80, REFERENCE_CYCLES);
+  model.setVoltageNoise(1, 50);
+  TOUCH_CHECK_EQUAL(model.getNoise(0, {0, REFERENCE_CYCLES}), 80);
+  TOUCH_CHECK_EQUAL(model.getNoise(0, {0, 4 * REFERENCE_CYCLES}), 40);    // Half the noise with four times the cycles
+  TOUCH_CHECK_EQUAL(model.getNoise(0, {1, REFERENCE_CYCLES}), 40);
+
+  model.apply({0, REFERENCE_CYCLES});
+  TOUCH_CHECK_EQUAL(model.read(0), BASELINE + 80);
+  TOUCH_CHECK_EQUAL(model.read(0), BASELINE - 80);
+
+  TouchAutoTuner tuner(voltages, 1, measCycles, 1);
+  TOUCH_CHECK_EQUAL(tuner.measure(model, {0, REFERENCE_CYCLES}), 400 * TUNE_SNR_ONE / 80);   // Threshold delta / noise
+}
+
+static void testTune() {
+  TouchTuneModel model(NUM_PADS, BASELINE, 0, REFERENCE_CYCLES);
+  setupModel(model);
+  TouchAutoTuner tuner(voltages, sizeof(voltages), measCycles, sizeof(measCycles) / sizeof(measCycles[0]));
+  tuner.setTargetSnr(5 * TUNE_SNR_ONE);
+
+  TouchTuneProfile expected = bruteForce(tuner, model, 5 * TUNE_SNR_ONE);
+  TOUCH_CHECK(expected.valid);
+  TOUCH_CHECK_EQUAL(expected.voltage, 2);
+  TOUCH_CHECK_EQUAL(expected.measCycles, 50);
+
+  TouchTuneProfile profile = tuner.tune(model);
+  TOUCH_CHECK(profile.valid);
+  TOUCH_CHECK_EQUAL(profile.voltage, expected.voltage);
+  TOUCH_CHECK_EQUAL(profile.measCycles, expected.measCycles);
+  TOUCH_CHECK_EQUAL(profile.snr, expected.snr);
+  TOUCH_CHECK(tuner.getMeasuredSettings() < sizeof(voltages) * sizeof(measCycles) / sizeof(measCycles[0]));   // Binary search
+  TOUCH_CHECK_EQUAL(tuner.getPadSnr(2), expected.snr);     // The noisiest pad
+  TOUCH_CHECK(tuner.getPadSnr(0) > expected.snr);
+}
+
+static void testTuneFails() {
+  TouchTuneModel model(NUM_PADS, BASELINE, 0, REFERENCE_CYCLES);
+  setupModel(model);
+  TouchAutoTuner tuner(voltages, sizeof(voltages), measCycles, sizeof(measCycles) / sizeof(measCycles[0]));
+  tuner.setTargetSnr(50 * TUNE_SNR_ONE);     // Out of reach
+
+  TouchTuneProfile expected = bruteForce(tuner, model, 50 * TUNE_SNR_ONE);
+  TOUCH_CHECK(!expected.valid);
+
+  TouchTuneProfile profile = tuner.tune(model);
+  TOUCH_CHECK(!profile.valid);
+  TOUCH_CHECK_EQUAL(profile.voltage, 2);     // Highest SNR: lowest voltage noise and longest measurement
+  TOUCH_CHECK_EQUAL(profile.measCycles, 800);
+  TOUCH_CHECK_EQUAL(profile.snr, expected.snr);
+}
+
+int main() {
+  testModel();
+  testTune();
+  testTuneFails();
+  return TOUCH_TEST_RESULT();
+}
@@ -0,0 +1,177 @@
+#include "TouchGestureClassifier.h"
+#include "TouchTest.h"
+
+// Features, fixed-point scoring and queue of TouchGestureClassifier.
+
+#define NUM_PADS          5
+#define ROW               (CLASSIFIER_FEATURES + 1)
+
+enum {CLASS_TAP = 1, CLASS_SWIPE_FIRST, CLASS_SWIPE_LAST};
+
+static const TouchClassifierNode tree[] = {
+  // feature, class, threshold, left (<=), right (>)
+  {FEATURE_PATH,         0,                 150, 1, 2},     // 0: barely moved?
+  {CLASSIFIER_LEAF,      CLASS_TAP,           0, 0, 0},     // 1: tap
+  {FEATURE_DISPLACEMENT, 0,                   0, 3, 4},     // 2: direction
+  {CLASSIFIER_LEAF,      CLASS_SWIPE_FIRST,   0, 0, 0},     // 3: swipe towards the first pad
+  {CLASSIFIER_LEAF,      CLASS_SWIPE_LAST,    0, 0, 0}      // 4: swipe towards the last pad
+};
+
+static uint8_t callbackCount = 0;
+
+static void classified(uint8_t classId) {
+  (void)classId;
+  callbackCount++;
+}
+
+/**
+ * @brief Run an episode with one touched pad per scan.
+ * @param classifier The classifier.
+ * @param pads Touched pad of each scan.
+ * @param numScans Number of scans.
+ * @return The class of the episode.
+ */
+static uint8_t runEpisode(TouchGestureClassifier &classifier, const uint8_t pads[], uint8_t numScans) {
+  uint32_t thresholds[NUM_PADS] = {200, 200, 200, 200, 200};
+  classifier.begin(20);
+  for (uint8_t scan = 0; scan < numScans; ++scan) {
+    uint32_t deltas[NUM_PADS] = {};
+    deltas[pads[scan]] = 400;
+    classifier.addScan(deltas, thresholds, NUM_PADS, 1);
+  }
+  return classifier.end();
+}
+
+static void testFeatures() {
+  TouchGestureClassifier classifier;
+  const uint8_t swipe[] = {0, 1, 2, 3, 4};
+  TOUCH_CHECK_EQUAL(runEpisode(classifier, swipe, 5), CLASSIFIER_NONE);    // No model
+  const int16_t *features = classifier.getFeatures();
+  TOUCH_CHECK_EQUAL(features[FEATURE_DURATION], 100);
+  TOUCH_CHECK_EQUAL(features[FEATURE_START], 0);
+  TOUCH_CHECK_EQUAL(features[FEATURE_END], CLASSIFIER_POSITION_SCALE);
+  TOUCH_CHECK_EQUAL(features[FEATURE_DISPLACEMENT], 1000);
+  TOUCH_CHECK_EQUAL(features[FEATURE_PATH], 1000);
+  TOUCH_CHECK_EQUAL(features[FEATURE_VELOCITY], 10000);        // Per-mille per second
+  TOUCH_CHECK_EQUAL(features[FEATURE_PEAK_VELOCITY], 12500);   // 250 per-mille in 20 ms
+  TOUCH_CHECK_EQUAL(features[FEATURE_REVERSALS], 0);
+  TOUCH_CHECK_EQUAL(features[FEATURE_PEAK_DELTA], 200);        // Twice the threshold
+  TOUCH_CHECK_EQUAL(features[FEATURE_MEAN_WIDTH], 16);         // One pad (Q4)
+  TOUCH_CHECK_EQUAL(features[FEATURE_MAX_CONTACTS], 1);
+
+  const uint8_t backAndForth[] = {0, 2, 0};
+  runEpisode(classifier, backAndForth, 3);
+  TOUCH_CHECK_EQUAL(features[FEATURE_DISPLACEMENT], 0);
+  TOUCH_CHECK_EQUAL(features[FEATURE_PATH], 1000);
+  TOUCH_CHECK_EQUAL(features[FEATURE_REVERSALS], 1);
+
+  uint32_t deltas[NUM_PADS] = {0, 300, 100, 0, 0};              // Between pads 1 and 2, weighted by the deltas
+  uint32_t thresholds[NUM_PADS] = {200, 200, 200, 200, 200};
+  classifier.begin(20);
+  classifier.addScan(deltas, thresholds, NUM_PADS, 1);
+  classifier.end();
+  TOUCH_CHECK_EQUAL(features[FEATURE_START], 312);              // (1 * 300 + 2 * 100) / 400 pads of 4
+  TOUCH_CHECK_EQUAL(features[FEATURE_MEAN_WIDTH], 16);
+}
+
+static void testLinear() {
+  static int16_t weights[3 * ROW] = {};
+  const uint8_t classIds[] = {CLASS_TAP, CLASS_SWIPE_FIRST, CLASS_SWIPE_LAST};
+  weights[0 * ROW] = -1000;                                    // Tap: -1000 + 1 * path
+  weights[0 * ROW + 1 + FEATURE_PATH] = 1;
+  weights[1 * ROW] = -256;                                     // Swipe to the first pad: -256 - 2 * displacement
+  weights[1 * ROW + 1 + FEATURE_DISPLACEMENT] = -2;
+  weights[2 * ROW] = -256;                                     // Swipe to the last pad: -256 + 2 * displacement
+  weights[2 * ROW + 1 + FEATURE_DISPLACEMENT] = 2;
+
+  TouchGestureClassifier classifier;
+  classifier.setLinearModel(weights, classIds, 3);
+  int16_t features[CLASSIFIER_FEATURES] = {};
+  TOUCH_CHECK_EQUAL(classifier.classify(features), CLASSIFIER_NONE);   // Every score is negative
+
+  features[FEATURE_DISPLACEMENT] = 128;                        // Score 0, not positive
+  TOUCH_CHECK_EQUAL(classifier.classify(features), CLASSIFIER_NONE);
+  features[FEATURE_DISPLACEMENT] = 129;
+  TOUCH_CHECK_EQUAL(classifier.classify(features), CLASS_SWIPE_LAST);
+  features[FEATURE_DISPLACEMENT] = -600;                       // 944
+  features[FEATURE_PATH] = 1944;                               // 944, the first row wins a tie
+  TOUCH_CHECK_EQUAL(classifier.classify(features), CLASS_TAP);
+  features[FEATURE_PATH] = 1943;
+  TOUCH_CHECK_EQUAL(classifier.classify(features), CLASS_SWIPE_FIRST);
+
+  static int16_t large[2 * ROW];                               // The score must not overflow
+  const uint8_t largeIds[] = {CLASS_TAP, CLASS_SWIPE_LAST};
+  for (uint8_t i = 0; i < ROW; ++i) {
+    large[i] = INT16_MAX;
+    large[ROW + i] = 0;
+  }
+  large[ROW] = 1;
+  for (uint8_t i = 0; i < CLASSIFIER_FEATURES; ++i) {
+    features[i] = INT16_MAX;
+  }
+  classifier.setLinearModel(large, largeIds, 2);
+  TOUCH_CHECK_EQUAL(classifier.classify(features), CLASS_TAP);
+}
+
+static void testTree() {
+  TouchGestureClassifier classifier;
+  classifier.setTreeModel(tree, sizeof(tree) / sizeof(tree[0]));
+  const uint8_t tap[] = {2, 2, 2};
+  const uint8_t swipeLast[] = {1, 2, 3};
+  const uint8_t swipeFirst[] = {4, 3, 2, 1};
+  TOUCH_CHECK_EQUAL(runEpisode(classifier, tap, 3), CLASS_TAP);
+  TOUCH_CHECK_EQUAL(runEpisode(classifier, swipeLast, 3), CLASS_SWIPE_LAST);
+  TOUCH_CHECK_EQUAL(runEpisode(classifier, swipeFirst, 4), CLASS_SWIPE_FIRST);
+  TOUCH_CHECK_EQUAL(classifier.getClass(), CLASS_TAP);
+  TOUCH_CHECK_EQUAL(classifier.getClass(), CLASS_SWIPE_LAST);
+  TOUCH_CHECK_EQUAL(classifier.getClass(), CLASS_SWIPE_FIRST);
+  TOUCH_CHECK_EQUAL(classifier.getClass(), CLASSIFIER_NONE);
+}
+
+static void testMalformedTree() {
+  const TouchClassifierNode loop[] = {
+    {FEATURE_PATH, 0, 0, 1, 1},
+    {FEATURE_PATH, 0, 0, 0, 0}
+  };
+  const TouchClassifierNode outOfRange[] = {
+    {FEATURE_PATH, 0, 0, 5, 5}
+  };
+  const TouchClassifierNode badFeature[] = {
+    {CLASSIFIER_FEATURES, 0, 0, 1, 1},
+    {CLASSIFIER_LEAF, CLASS_TAP, 0, 0, 0}
+  };
+  int16_t features[CLASSIFIER_FEATURES] = {};
+  TouchGestureClassifier classifier;
+  classifier.setTreeModel(loop, 2);
+  TOUCH_CHECK_EQUAL(classifier.classify(features), CLASSIFIER_NONE);
+  classifier.setTreeModel(outOfRange, 1);
+  TOUCH_CHECK_EQUAL(classifier.classify(features), CLASSIFIER_NONE);
+  classifier.setTreeModel(badFeature, 2);
+  TOUCH_CHECK_EQUAL(classifier.classify(features), CLASSIFIER_NONE);
+}
+
+static void testQueueFull() {
+  TouchGestureClassifier classifier;
+  classifier.setTreeModel(tree, sizeof(tree) / sizeof(tree[0]));
+  classifier.setCallback(classified);
+  const uint8_t tap[] = {2};
+  for (uint8_t i = 0; i < CLASSIFIER_QUEUE_SIZE + 2; ++i) {
+    runEpisode(classifier, tap, 1);
+  }
+  TOUCH_CHECK_EQUAL(callbackCount, CLASSIFIER_QUEUE_SIZE + 2);   // The callback sees every episode
+
+  uint8_t queued = 0;
+  while (classifier.getClass() == CLASS_TAP) {
+    queued++;
+  }
+  TOUCH_CHECK_EQUAL(queued, CLASSIFIER_QUEUE_SIZE - 1);          // The newest ones are dropped
+}
+
+int main() {
+  testFeatures();
+  testLinear();
+  testTree();
+  testMalformedTree();
+  testQueueFull();
+  return TOUCH_TEST_RESULT();
+}
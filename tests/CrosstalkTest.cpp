@@ -0,0 +1,151 @@
+#include "TouchSlider.h"
+#include "TouchTest.h"
+
+// Crosstalk compensation of the slider: calibration of the coupling between neighbour pads and the tridiagonal
+// decoupling of the deltas, on pads that see 35% of the previous pad and 40% of the next one.
+
+#define NUM_PADS          5
+#define BASELINE          1000            // The threshold is 20% (200 counts)
+#define FROM_LOWER        35              // Percentage of the delta of the previous pad seen on each pad
+#define FROM_UPPER        40              // Percentage of the delta of the next pad seen on each pad
+
+static TouchSlider slider(touchTestPins, 80, NUM_PADS);
+
+/**
+ * @brief Run one scan with the crosstalk of the electrodes.
+ * @param deltas True delta of each pad, before the coupling.
+ */
+static void scanDeltas(const int32_t deltas[]) {
+  uint32_t values[NUM_PADS];
+  for (uint8_t i = 0; i < NUM_PADS; ++i) {
+    int32_t measured = deltas[i];
+    if (i > 0) measured += deltas[i - 1] * FROM_LOWER / 100;
+    if (i + 1 < NUM_PADS) measured += deltas[i + 1] * FROM_UPPER / 100;
+    values[i] = touchTestValue(BASELINE, measured);
+  }
+  slider.simulateScan(values);
+}
+
+/**
+ * @brief Run one scan with a single pad touched.
+ * @param pad The touched pad, -1 for no touch.
+ * @param delta True delta of the pad.
+ */
+static void scanPad(int8_t pad, int32_t delta) {
+  int32_t deltas[NUM_PADS] = {};
+  if (pad >= 0) deltas[pad] = delta;
+  scanDeltas(deltas);
+}
+
+/**
+ * @brief Check the touched pads of the last scan.
+ * @param first First touched pad.
+ * @param last Last touched pad.
+ * @return true if only the pads between first and last are touched.
+ */
+static bool touchedPads(uint8_t first, uint8_t last) {
+  bool touched[NUM_PADS];
+  slider.getSliderTouched(touched, NUM_PADS);
+  for (uint8_t i = 0; i < NUM_PADS; ++i) {
+    if (touched[i] != (i >= first && i <= last))
+      return false;
+  }
+  return true;
+}
+
+static void testWithoutCompensation() {
+  scanPad(2, 700);
+  TOUCH_CHECK(touchedPads(1, 3));             // The neighbours see 245 and 280 counts
+  scanPad(-1, 0);
+}
+
+static void testCalibration() {
+  slider.startCrosstalkCalibration();
+  for (int8_t pad = 0; pad < NUM_PADS; ++pad) {
+    for (uint8_t i = 0; i < CROSSTALK_MIN_SAMPLES; ++i) {
+      scanPad(pad, 500);
+    }
+    scanPad(-1, 0);
+  }
+  TOUCH_CHECK(slider.stopCrosstalkCalibration());
+
+  TouchCrosstalkProfile profile = slider.getCrosstalkProfile();
+  TOUCH_CHECK_EQUAL(profile.numPads, NUM_PADS);
+  TOUCH_CHECK_EQUAL(profile.fromLower[0], 0);
+  TOUCH_CHECK_EQUAL(profile.fromUpper[NUM_PADS - 1], 0);
+  for (uint8_t i = 1; i < NUM_PADS; ++i) {
+    TOUCH_CHECK_EQUAL(profile.fromLower[i], FROM_LOWER * 256 / 100);
+    TOUCH_CHECK_EQUAL(profile.fromUpper[i - 1], FROM_UPPER * 256 / 100);
+  }
+}
+
+static void testIncompleteCalibration() {
+  TouchCrosstalkProfile before = slider.getCrosstalkProfile();
+  slider.startCrosstalkCalibration();
+  for (uint8_t i = 0; i < CROSSTALK_MIN_SAMPLES; ++i) {
+    scanPad(0, 500);                          // Only the first pad
+  }
+  scanPad(-1, 0);
+  TOUCH_CHECK(!slider.stopCrosstalkCalibration());
+  TouchCrosstalkProfile after = slider.getCrosstalkProfile();
+  TOUCH_CHECK_EQUAL(after.fromLower[1], before.fromLower[1]);
+  TOUCH_CHECK_EQUAL(after.fromUpper[2], before.fromUpper[2]);
+}
+
+static void testDecoupling() {
+  for (int8_t pad = 0; pad < NUM_PADS; ++pad) {
+    scanPad(pad, 700);
+    TOUCH_CHECK(touchedPads(pad, pad));
+    scanPad(pad, 250);                        // A light touch is still seen
+    TOUCH_CHECK(touchedPads(pad, pad));
+    scanPad(-1, 0);
+  }
+
+  const int32_t twoFingers[NUM_PADS] = {0, 700, 0, 700, 0};   // Pad 2 sees 525 counts from both neighbours
+  scanDeltas(twoFingers);
+  SliderContact contacts[2];
+  TOUCH_CHECK_EQUAL(slider.getContacts(contacts, 2), 2);
+  TOUCH_CHECK_EQUAL(contacts[0].position, 2);
+  TOUCH_CHECK_EQUAL(contacts[1].position, 6);
+  scanPad(-1, 0);
+
+  const int32_t weakNeighbour[NUM_PADS] = {0, 230, 700, 0, 0};   // Pad 1 is touched, pad 3 only sees the leak
+  scanDeltas(weakNeighbour);
+  TOUCH_CHECK(touchedPads(1, 2));
+  const int32_t belowThreshold[NUM_PADS] = {0, 170, 700, 0, 0};
+  scanDeltas(belowThreshold);
+  TOUCH_CHECK(touchedPads(2, 2));
+  scanPad(-1, 0);
+}
+
+static void testProfile() {
+  TouchCrosstalkProfile profile = {};
+  profile.numPads = NUM_PADS - 1;             // Wrong slider, rejected
+  slider.setCrosstalkProfile(profile);
+  TOUCH_CHECK_EQUAL(slider.getCrosstalkProfile().numPads, NUM_PADS);
+
+  profile.numPads = NUM_PADS;
+  profile.fromLower[1] = 255;                 // Clamped, it is not crosstalk
+  slider.setCrosstalkProfile(profile);
+  TOUCH_CHECK_EQUAL(slider.getCrosstalkProfile().fromLower[1], CROSSTALK_MAX_COUPLING);
+
+  slider.disableCrosstalkCompensation();
+  scanPad(2, 700);
+  TOUCH_CHECK(touchedPads(1, 3));
+  scanPad(-1, 0);
+}
+
+int main() {
+  slider.disablePrintSliderTouched();
+  slider.disablePrintSwipeStatus();
+  slider.disableTouchButtons();
+  uint32_t baseline[NUM_PADS] = {BASELINE, BASELINE, BASELINE, BASELINE, BASELINE};
+  slider.beginSimulation(baseline);
+
+  testWithoutCompensation();
+  testCalibration();
+  testIncompleteCalibration();
+  testDecoupling();
+  testProfile();
+  return TOUCH_TEST_RESULT();
+}
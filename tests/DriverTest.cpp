@@ -0,0 +1,87 @@
+#include "TouchSlider.h"
+#include "TouchTest.h"
+
+// Backend logic of TouchDriver (threshold, delta direction, baseline source) and the calibration of the slider on the
+// driver stand-in, built for the ESP32 (v1) and ESP32-S2/S3 (v2) touch sensors.
+
+#define NUM_PADS          3
+#define BASELINE          1000
+
+static void testThreshold() {
+  TOUCH_CHECK_EQUAL(TouchDriver::thresholdFromBaseline(BASELINE, 80), 200);
+  TOUCH_CHECK_EQUAL(TouchDriver::thresholdFromBaseline(BASELINE, 0), BASELINE);
+  TOUCH_CHECK_EQUAL(TouchDriver::thresholdFromBaseline(BASELINE, 100), 0);
+  TOUCH_CHECK_EQUAL(TouchDriver::thresholdFromBaseline(BASELINE, 150), 0);
+}
+
+static void testDeltaDirection() {
+  uint32_t towards = touchTestValue(BASELINE, 300);
+  uint32_t away = touchTestValue(BASELINE, -300);
+  if (TouchDriver::tracksBaseline()) {
+    TOUCH_CHECK(towards > BASELINE);      // v2: the value rises on touch
+  } else {
+    TOUCH_CHECK(towards < BASELINE);      // v1: the value drops on touch
+  }
+
+  TOUCH_CHECK_EQUAL(TouchDriver::touchDelta(towards, BASELINE), 300);
+  TOUCH_CHECK_EQUAL(TouchDriver::touchDelta(away, BASELINE), 0);
+  TOUCH_CHECK_EQUAL(TouchDriver::touchChange(towards, BASELINE), 300);
+  TOUCH_CHECK_EQUAL(TouchDriver::touchChange(away, BASELINE), -300);
+
+  TOUCH_CHECK(TouchDriver::isTouched(touchTestValue(BASELINE, 201), BASELINE, 200));
+  TOUCH_CHECK(!TouchDriver::isTouched(touchTestValue(BASELINE, 200), BASELINE, 200));
+  TOUCH_CHECK(!TouchDriver::isTouched(away, BASELINE, 200));
+}
+
+static void testBaselineSource() {
+  touch_pad_t pad = TouchDriver::mapGpioToTouchPad(touchTestPins[0]);
+  TouchDriverHost::setFiltered(pad, 900);
+  TouchDriverHost::setBaseline(pad, 1000);
+  if (TouchDriver::tracksBaseline()) {
+    TOUCH_CHECK_EQUAL(TouchDriver::readBaseline(pad), 1000);    // v2: hardware benchmark
+  } else {
+    TOUCH_CHECK_EQUAL(TouchDriver::readBaseline(pad), 900);     // v1: filtered value
+  }
+}
+
+static void testWaitBaseline() {
+  touch_pad_t pad = TouchDriver::mapGpioToTouchPad(touchTestPins[1]);
+  TouchDriverHost::setFiltered(pad, 0);     // No measurement yet
+  TouchDriverHost::setBaseline(pad, 0);
+  TOUCH_CHECK(!TouchDriver::waitBaseline(pad, 50));
+
+  TouchDriverHost::setFiltered(pad, BASELINE);
+  TouchDriverHost::setBaseline(pad, BASELINE);
+  TOUCH_CHECK(TouchDriver::waitBaseline(pad, 50));
+}
+
+static void testCalibration() {
+  TouchSlider slider(touchTestPins, 80, NUM_PADS);
+  slider.disablePrintSliderTouched();
+  slider.disablePrintSwipeStatus();
+  for (uint8_t i = 0; i < NUM_PADS; ++i) {
+    touch_pad_t pad = TouchDriver::mapGpioToTouchPad(touchTestPins[i]);
+    TouchDriverHost::setFiltered(pad, BASELINE + 100 * i);
+    TouchDriverHost::setBaseline(pad, BASELINE + 100 * i);
+  }
+
+  slider.start();
+  TOUCH_CHECK(TouchDriverHost::isRunning());
+  for (uint8_t i = 0; i < NUM_PADS; ++i) {
+    touch_pad_t pad = TouchDriver::mapGpioToTouchPad(touchTestPins[i]);
+    TOUCH_CHECK(TouchDriverHost::isConfigured(pad));
+    TOUCH_CHECK_EQUAL(TouchDriverHost::getThreshold(pad), (BASELINE + 100 * i) / 5);   // 20% of the baseline
+    TOUCH_CHECK(!slider.isTouchSliderPressed(touchTestPins[i]));
+  }
+  slider.stop();
+  TOUCH_CHECK(!TouchDriverHost::isRunning());
+}
+
+int main() {
+  testThreshold();
+  testDeltaDirection();
+  testBaselineSource();
+  testWaitBaseline();
+  testCalibration();
+  return TOUCH_TEST_RESULT();
+}
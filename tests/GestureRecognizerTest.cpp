@@ -0,0 +1,66 @@
+#include "TouchGestureRecognizer.h"
+#include "TouchTest.h"
+
+// Pattern matching and gesture queue of TouchGestureRecognizer.
+
+enum {GESTURE_TAP = 1, GESTURE_FLICK_UP};
+
+static const TouchGesturePattern patterns[] = {
+  {GESTURE_TAP,      4, 0,                       {STROKE_TOUCH_MID, STROKE_RELEASE}},
+  {GESTURE_FLICK_UP, 4, STROKE_BIT(STROKE_HOLD), {STROKE_TOUCH_BOT, GESTURE_REPEAT(STROKE_SWIPE_UP), STROKE_RELEASE}}
+};
+
+static uint8_t callbackCount = 0;
+
+static void gestureRecognized(uint8_t gestureId) {
+  (void)gestureId;
+  callbackCount++;
+}
+
+static void testPatterns() {
+  TouchGestureRecognizer recognizer;
+  recognizer.setPatterns(patterns, 2);
+
+  recognizer.feed(STROKE_TOUCH_BOT);
+  recognizer.feed(STROKE_SWIPE_UP);
+  recognizer.feed(STROKE_HOLD);           // Ignored
+  recognizer.feed(STROKE_SWIPE_UP);       // Repeated
+  recognizer.feed(STROKE_RELEASE);
+  TOUCH_CHECK_EQUAL(recognizer.getGesture(), GESTURE_FLICK_UP);
+
+  recognizer.feed(STROKE_TOUCH_MID);
+  for (uint8_t i = 0; i < 5; ++i) {       // Longer than maxGapScans
+    recognizer.tick();
+  }
+  recognizer.feed(STROKE_RELEASE);
+  TOUCH_CHECK_EQUAL(recognizer.getGesture(), GESTURE_NONE);
+}
+
+static void testQueueFull() {
+  TouchGestureRecognizer recognizer;
+  recognizer.setPatterns(patterns, 2);
+  recognizer.setCallback(gestureRecognized);
+
+  for (uint8_t i = 0; i < GESTURE_QUEUE_SIZE + 2; ++i) {
+    recognizer.feed(STROKE_TOUCH_MID);
+    recognizer.feed(STROKE_RELEASE);
+  }
+  TOUCH_CHECK_EQUAL(callbackCount, GESTURE_QUEUE_SIZE + 2);    // The callback sees every gesture
+
+  uint8_t queued = 0;
+  while (recognizer.getGesture() == GESTURE_TAP) {
+    queued++;
+  }
+  TOUCH_CHECK_EQUAL(queued, GESTURE_QUEUE_SIZE - 1);           // The newest ones are dropped
+
+  recognizer.feed(STROKE_TOUCH_MID);      // Room again after reading
+  recognizer.feed(STROKE_RELEASE);
+  TOUCH_CHECK_EQUAL(recognizer.getGesture(), GESTURE_TAP);
+  TOUCH_CHECK_EQUAL(recognizer.getGesture(), GESTURE_NONE);
+}
+
+int main() {
+  testPatterns();
+  testQueueFull();
+  return TOUCH_TEST_RESULT();
+}
@@ -0,0 +1,215 @@
+#include "TouchSlider.h"
+#include "TouchTest.h"
+
+// Metrics frames of the slider: prepared by the scan, written by flushMetrics() and decoded on the host side, the
+// checks of decodeFrame() and the noise, scan jitter and events per second carried by the frames.
+
+#define NUM_PADS          3
+#define BASELINE          1000
+
+static TouchSlider slider(touchTestPins, 80, NUM_PADS);
+
+struct FrameSink {
+  uint8_t frame[METRICS_FRAME_MAX_SIZE];
+  size_t length;
+  uint8_t writes;
+  bool fail;
+};
+
+static size_t writeFrame(const uint8_t frame[], size_t length, void *context) {
+  FrameSink *sink = static_cast<FrameSink*>(context);
+  sink->writes++;
+  if (sink->fail)
+    return length / 2;
+  for (size_t i = 0; i < length; ++i) {
+    sink->frame[i] = frame[i];
+  }
+  sink->length = length;
+  return length;
+}
+
+static void scan() {
+  uint32_t values[NUM_PADS] = {BASELINE, BASELINE, BASELINE};
+  slider.simulateScan(values);
+}
+
+static void testFlush() {
+  FrameSink sink = {};
+  slider.enableMetricsWriter(writeFrame, &sink, slider.getUpdateInterval());   // One frame per scan
+
+  TOUCH_CHECK(!slider.flushMetrics());
+  scan();
+  TOUCH_CHECK_EQUAL(sink.writes, 0);      // Never written from the scan
+  TOUCH_CHECK(slider.flushMetrics());
+  TOUCH_CHECK_EQUAL(sink.writes, 1);
+  TOUCH_CHECK(!slider.flushMetrics());    // Written only once
+
+  TouchMetricsSnapshot snapshot;
+  TOUCH_CHECK(TouchMetrics::decodeFrame(sink.frame, sink.length, snapshot));
+  TOUCH_CHECK_EQUAL(sink.frame[2], METRICS_FRAME_VERSION);
+  TOUCH_CHECK_EQUAL(snapshot.numPads, NUM_PADS);
+  TOUCH_CHECK_EQUAL(snapshot.counters[METRIC_DROPPED_FRAMES], 0);
+  slider.disableMetricsStream();
+}
+
+static void testDropped() {
+  FrameSink sink = {};
+  uint32_t dropped = slider.getMetrics().getCounter(METRIC_DROPPED_FRAMES);
+  slider.enableMetricsWriter(writeFrame, &sink, slider.getUpdateInterval());
+
+  scan();
+  scan();                                 // The first frame is still pending, the second one is dropped
+  TOUCH_CHECK_EQUAL(slider.getMetrics().getCounter(METRIC_DROPPED_FRAMES), dropped + 1);
+  TOUCH_CHECK(slider.flushMetrics());
+
+  sink.fail = true;
+  scan();
+  TOUCH_CHECK(!slider.flushMetrics());    // Written partially
+  TOUCH_CHECK_EQUAL(slider.getMetrics().getCounter(METRIC_DROPPED_FRAMES), dropped + 1);
+  sink.fail = false;
+  scan();                                 // Counted by the scan, the producer owns the counters
+  TOUCH_CHECK_EQUAL(slider.getMetrics().getCounter(METRIC_DROPPED_FRAMES), dropped + 2);
+  TOUCH_CHECK(slider.flushMetrics());
+
+  TouchMetricsSnapshot snapshot;
+  TOUCH_CHECK(TouchMetrics::decodeFrame(sink.frame, sink.length, snapshot));
+  TOUCH_CHECK_EQUAL(snapshot.counters[METRIC_DROPPED_FRAMES], dropped + 2);
+  slider.disableMetricsStream();
+}
+
+/**
+ * @brief Encode a frame of a registry with two pads.
+ * @param frame Buffer of METRICS_FRAME_MAX_SIZE bytes.
+ * @return The length of the frame.
+ */
+static size_t encodeTwoPads(uint8_t frame[]) {
+  TouchMetrics metrics;
+  metrics.recordPad(3, BASELINE, BASELINE, false);
+  metrics.recordPad(7, BASELINE, BASELINE, false);
+  return metrics.encodeFrame(frame, METRICS_FRAME_MAX_SIZE, 1000);
+}
+
+/**
+ * @brief Write the CRC of a modified frame, so only the modified field is wrong.
+ */
+static void signFrame(uint8_t frame[], size_t length) {
+  uint16_t crc = TouchMetrics::crc16(frame, length - 2);
+  frame[length - 2] = crc & 0xFF;
+  frame[length - 1] = crc >> 8;
+}
+
+static void testDecodeChecks() {
+  uint8_t frame[METRICS_FRAME_MAX_SIZE + 1] = {};
+  TouchMetricsSnapshot snapshot;
+  size_t length = encodeTwoPads(frame);
+  TOUCH_CHECK(TouchMetrics::decodeFrame(frame, length, snapshot));
+  TOUCH_CHECK_EQUAL(snapshot.numPads, 2);
+  TOUCH_CHECK_EQUAL(snapshot.pads[1].pad, 7);
+
+  TOUCH_CHECK(!TouchMetrics::decodeFrame(frame, length - 1, snapshot));   // Truncated
+  TOUCH_CHECK(!TouchMetrics::decodeFrame(frame, length + 1, snapshot));   // Longer than its pads
+  TOUCH_CHECK(!TouchMetrics::decodeFrame(frame, 10, snapshot));           // Shorter than the header
+
+  frame[8] ^= 0x01;                       // Corrupted uptime
+  TOUCH_CHECK(!TouchMetrics::decodeFrame(frame, length, snapshot));
+  frame[8] ^= 0x01;
+  frame[length - 1] ^= 0x80;              // Corrupted CRC
+  TOUCH_CHECK(!TouchMetrics::decodeFrame(frame, length, snapshot));
+  frame[length - 1] ^= 0x80;
+  TOUCH_CHECK(TouchMetrics::decodeFrame(frame, length, snapshot));
+
+  frame[2] = METRICS_FRAME_VERSION + 1;   // Another version
+  signFrame(frame, length);
+  TOUCH_CHECK(!TouchMetrics::decodeFrame(frame, length, snapshot));
+  frame[2] = METRICS_FRAME_VERSION;
+  frame[0] = 'X';                         // Bad magic
+  signFrame(frame, length);
+  TOUCH_CHECK(!TouchMetrics::decodeFrame(frame, length, snapshot));
+  frame[0] = 'T';
+  frame[3] = METRICS_MAX_PADS + 1;        // More pads than a frame can carry
+  signFrame(frame, length);
+  TOUCH_CHECK(!TouchMetrics::decodeFrame(frame, length, snapshot));
+  frame[3] = 2;
+  signFrame(frame, length);
+  TOUCH_CHECK(TouchMetrics::decodeFrame(frame, length, snapshot));
+}
+
+static void testNoise() {
+  TouchMetrics metrics;
+  for (uint8_t i = 0; i < 100; ++i) {     // Untouched pad moving 8 counts between scans
+    metrics.recordPad(0, BASELINE, i % 2 == 0 ? BASELINE : BASELINE + 8, false);
+  }
+  uint8_t frame[METRICS_FRAME_MAX_SIZE];
+  TouchMetricsSnapshot snapshot;
+  TOUCH_CHECK(TouchMetrics::decodeFrame(frame, metrics.encodeFrame(frame, sizeof(frame), 0), snapshot));
+  TOUCH_CHECK(snapshot.pads[0].noise > 8 * 16 - 16);     // 8 counts (Q4), within a count of the average
+  TOUCH_CHECK(snapshot.pads[0].noise <= 8 * 16);
+  uint16_t noise = snapshot.pads[0].noise;
+
+  metrics.recordPad(0, BASELINE, BASELINE + 300, true);  // A touch is not noise
+  metrics.recordPad(0, BASELINE, BASELINE, true);
+  TOUCH_CHECK(TouchMetrics::decodeFrame(frame, metrics.encodeFrame(frame, sizeof(frame), 0), snapshot));
+  TOUCH_CHECK_EQUAL(snapshot.pads[0].noise, noise);
+  TOUCH_CHECK_EQUAL(snapshot.pads[0].filtered, BASELINE);
+  TOUCH_CHECK_EQUAL(snapshot.pads[0].baseline, BASELINE);
+}
+
+static void testJitter() {
+  TouchMetrics metrics;
+  metrics.recordScan(9000, 10000);
+  metrics.recordScan(11000, 10000);
+  metrics.recordScan(10000, 10000);
+
+  uint8_t frame[METRICS_FRAME_MAX_SIZE];
+  TouchMetricsSnapshot snapshot;
+  TOUCH_CHECK(TouchMetrics::decodeFrame(frame, metrics.encodeFrame(frame, sizeof(frame), 0), snapshot));
+  TOUCH_CHECK_EQUAL(snapshot.counters[METRIC_SCANS], 3);
+  TOUCH_CHECK_EQUAL(snapshot.scanIntervalMinUs, 9000);
+  TOUCH_CHECK_EQUAL(snapshot.scanIntervalMaxUs, 11000);
+  TOUCH_CHECK_EQUAL(snapshot.scanJitterUs, 666);          // (1000 + 1000 + 0) / 3
+  TOUCH_CHECK_EQUAL(snapshot.sequence, 0);
+
+  TOUCH_CHECK(TouchMetrics::decodeFrame(frame, metrics.encodeFrame(frame, sizeof(frame), 0), snapshot));
+  TOUCH_CHECK_EQUAL(snapshot.scanIntervalMinUs, 0);       // New window without scans
+  TOUCH_CHECK_EQUAL(snapshot.scanIntervalMaxUs, 0);
+  TOUCH_CHECK_EQUAL(snapshot.scanJitterUs, 0);
+  TOUCH_CHECK_EQUAL(snapshot.counters[METRIC_SCANS], 3);  // The counters are totals
+  TOUCH_CHECK_EQUAL(snapshot.sequence, 1);
+}
+
+static void testEventsPerSecond() {
+  TouchMetrics metrics;
+  uint8_t frame[METRICS_FRAME_MAX_SIZE];
+  TouchMetricsSnapshot previous;
+  TouchMetricsSnapshot current;
+  TOUCH_CHECK(TouchMetrics::decodeFrame(frame, metrics.encodeFrame(frame, sizeof(frame), 1000), previous));
+
+  for (uint8_t i = 0; i < 3; ++i) {
+    metrics.increment(METRIC_SWIPE_UP);
+  }
+  metrics.increment(METRIC_SWIPE_FINE_DOWN);
+  metrics.increment(METRIC_BUTTON_PRESSES);
+  for (uint8_t i = 0; i < 20; ++i) {      // Not slider events
+    metrics.increment(METRIC_SCANS);
+    metrics.increment(METRIC_TOUCHES);
+  }
+  TOUCH_CHECK(TouchMetrics::decodeFrame(frame, metrics.encodeFrame(frame, sizeof(frame), 1500), current));
+  TOUCH_CHECK_EQUAL(TouchMetrics::eventsPerSecond(previous, current), 10);   // 5 events in 500 ms
+  TOUCH_CHECK_EQUAL(TouchMetrics::eventsPerSecond(current, current), 0);
+}
+
+int main() {
+  slider.disablePrintSliderTouched();
+  slider.disablePrintSwipeStatus();
+  slider.disableTouchButtons();
+  uint32_t baseline[NUM_PADS] = {BASELINE, BASELINE, BASELINE};
+  slider.beginSimulation(baseline);
+
+  testFlush();
+  testDropped();
+  testDecodeChecks();
+  testNoise();
+  testJitter();
+  testEventsPerSecond();
+  return TOUCH_TEST_RESULT();
+}
@@ -0,0 +1,96 @@
+#include "TouchSlider.h"
+#include "TouchTest.h"
+
+// Common-mode compensation of the reference pad: every pad, the reference included, drifts 0 to 30% of its baseline
+// towards touch (temperature, supply), on pads of different sizes. The touch threshold is 20% of the baseline.
+
+#define NUM_PADS          5
+#define REFERENCE_BASELINE 900
+#define MAX_DRIFT         30              // Percentage of the baselines
+#define TOUCH_PERCENT     30              // Change of a touched pad, percentage of its baseline
+
+static const uint32_t baselines[NUM_PADS] = {800, 900, 1000, 1100, 1200};
+
+static TouchSlider slider(touchTestPins, 80, NUM_PADS);
+
+static uint16_t falseScans = 0;           // Scans of untouched pads reported as touched
+static uint16_t touchScans = 0;           // Scans of the touched pad reported as touched
+
+/**
+ * @brief Drift every pad from 0 to MAX_DRIFT %, one percent per scan.
+ * @param referenceBaseline Baseline of the reference pad, 0 without reference.
+ * @param touchPad Pad touched during the whole drift, -1 for no touch.
+ */
+static void runDrift(uint32_t referenceBaseline, int8_t touchPad) {
+  falseScans = 0;
+  touchScans = 0;
+  slider.beginSimulation(baselines, referenceBaseline);
+  for (int32_t drift = 0; drift <= MAX_DRIFT; ++drift) {
+    uint32_t values[NUM_PADS];
+    for (int8_t i = 0; i < NUM_PADS; ++i) {
+      int32_t delta = baselines[i] * drift / 100;
+      if (i == touchPad) delta += baselines[i] * TOUCH_PERCENT / 100;
+      values[i] = touchTestValue(baselines[i], delta);
+    }
+    slider.simulateScan(values, referenceBaseline > 0 ? touchTestValue(referenceBaseline, referenceBaseline * drift / 100) : 0);
+
+    bool touched[NUM_PADS];
+    slider.getSliderTouched(touched, NUM_PADS);
+    for (int8_t i = 0; i < NUM_PADS; ++i) {
+      if (!touched[i]) continue;
+      if (i == touchPad) touchScans++;
+      else falseScans++;
+    }
+  }
+}
+
+static void testWithoutReference() {
+  runDrift(0, -1);
+  TOUCH_CHECK_EQUAL(falseScans, 10 * NUM_PADS);      // Every pad from 21% to 30%
+  TOUCH_CHECK_EQUAL(slider.getReferenceCompensation(), 0);
+}
+
+static void testReferencePin() {
+  slider.setReferencePad(touchTestPins[0]);          // A slider pin can not be the reference
+  TOUCH_CHECK_EQUAL(slider.getReferencePad(), GPIO_NUM_NC);
+  slider.setReferencePad(TOUCH_TEST_FREE_PIN);
+  TOUCH_CHECK_EQUAL(slider.getReferencePad(), TOUCH_TEST_FREE_PIN);
+}
+
+static void testDrift() {
+  slider.setReferencePad(TOUCH_TEST_FREE_PIN);
+  runDrift(REFERENCE_BASELINE, -1);
+  TOUCH_CHECK_EQUAL(falseScans, 0);
+  TOUCH_CHECK(slider.getReferenceCompensation() >= 100 * MAX_DRIFT - 1);
+  TOUCH_CHECK(slider.getReferenceCompensation() <= 100 * MAX_DRIFT);
+
+  runDrift(REFERENCE_BASELINE, 2);                   // A real touch still stands out of the drift
+  TOUCH_CHECK_EQUAL(falseScans, 0);
+  TOUCH_CHECK_EQUAL(touchScans, MAX_DRIFT + 1);
+
+  uint8_t frame[METRICS_FRAME_MAX_SIZE];
+  size_t length = slider.getMetrics().encodeFrame(frame, sizeof(frame), 1);
+  TouchMetricsSnapshot snapshot;
+  TOUCH_CHECK(TouchMetrics::decodeFrame(frame, length, snapshot));
+  TOUCH_CHECK_EQUAL(snapshot.commonMode, slider.getReferenceCompensation());
+  TOUCH_CHECK(snapshot.commonModePeak >= snapshot.commonMode);
+}
+
+static void testRemoveReference() {
+  slider.setReferencePad(GPIO_NUM_NC);
+  TOUCH_CHECK_EQUAL(slider.getReferencePad(), GPIO_NUM_NC);
+  runDrift(REFERENCE_BASELINE, -1);
+  TOUCH_CHECK_EQUAL(falseScans, 10 * NUM_PADS);
+}
+
+int main() {
+  slider.disablePrintSliderTouched();
+  slider.disablePrintSwipeStatus();
+  slider.disableTouchButtons();
+
+  testWithoutReference();
+  testReferencePin();
+  testDrift();
+  testRemoveReference();
+  return TOUCH_TEST_RESULT();
+}
@@ -0,0 +1,93 @@
+#include "TouchSlider.h"
+#include "TouchSegmentDecoder.h"
+#include "TouchGestureClassifier.h"
+#include "TouchTest.h"
+
+// Interleaved slider: swipes and classifier positions in segments, and the crosstalk compensation disabled while the
+// segment decoder is attached.
+
+#define NUM_PADS          5
+#define NUM_SEGMENTS      11
+#define BASELINE          1000            // The threshold is 20% (200 counts)
+#define TOUCH_DELTA       400
+#define NEIGHBOUR_DELTA   150             // Below the threshold, enough to pair the channels of a boundary
+
+static const uint8_t layout[NUM_SEGMENTS] = {0, 1, 2, 3, 4, 0, 2, 4, 1, 3, 0};
+
+static TouchSlider slider(touchTestPins, 80, NUM_PADS);
+
+/**
+ * @brief Run one scan with a finger on a segment, its next segment (previous one for the last) is grazed.
+ * @param segment The touched segment, -1 for no touch.
+ */
+static void scanSegment(int8_t segment) {
+  uint32_t values[NUM_PADS];
+  for (uint8_t i = 0; i < NUM_PADS; ++i) {
+    values[i] = BASELINE;
+  }
+  if (segment >= 0) {
+    uint8_t neighbour = segment + 1 < NUM_SEGMENTS ? segment + 1 : segment - 1;
+    values[layout[neighbour]] = touchTestValue(BASELINE, NEIGHBOUR_DELTA);
+    values[layout[segment]] = touchTestValue(BASELINE, TOUCH_DELTA);
+  }
+  slider.simulateScan(values);
+}
+
+static void testCrosstalkDisabled() {
+  TouchCrosstalkProfile profile = {};
+  profile.numPads = NUM_PADS;
+  slider.setCrosstalkProfile(profile);
+  TOUCH_CHECK_EQUAL(slider.getCrosstalkProfile().numPads, NUM_PADS);
+
+  TouchSegmentDecoder decoder;
+  TOUCH_CHECK(decoder.setLayout(layout, NUM_SEGMENTS, NUM_PADS));
+  TOUCH_CHECK(slider.attachSegmentDecoder(&decoder));
+  TOUCH_CHECK_EQUAL(slider.getCrosstalkProfile().numPads, 0);     // Dropped by the decoder
+
+  slider.setCrosstalkProfile(profile);                           // Rejected while the decoder is attached
+  TOUCH_CHECK_EQUAL(slider.getCrosstalkProfile().numPads, 0);
+  slider.startCrosstalkCalibration();
+  TOUCH_CHECK(!slider.stopCrosstalkCalibration());
+  TOUCH_CHECK_EQUAL(slider.getCrosstalkProfile().numPads, 0);
+}
+
+static void testSwipeSegments() {
+  TouchSegmentDecoder decoder;
+  TouchGestureClassifier classifier;
+  decoder.setLayout(layout, NUM_SEGMENTS, NUM_PADS);
+  slider.attachSegmentDecoder(&decoder);
+  slider.attachGestureClassifier(&classifier);
+
+  uint32_t values[NUM_PADS];
+  for (uint8_t i = 0; i < NUM_PADS; ++i) {
+    values[i] = BASELINE;
+  }
+  slider.beginSimulation(values);
+  scanSegment(-1);
+  slider.getSwipeStatus();
+  for (int8_t segment = 0; segment < NUM_SEGMENTS; ++segment) {   // The channels go back and forth, the segments do not
+    scanSegment(segment);
+  }
+  scanSegment(-1);
+
+  TOUCH_CHECK_EQUAL(slider.getSwipeStatus(), -2 * (NUM_SEGMENTS - 1));
+  const int16_t *features = classifier.getFeatures();
+  TOUCH_CHECK_EQUAL(features[FEATURE_START], 0);
+  TOUCH_CHECK_EQUAL(features[FEATURE_END], CLASSIFIER_POSITION_SCALE);
+  TOUCH_CHECK_EQUAL(features[FEATURE_DISPLACEMENT], CLASSIFIER_POSITION_SCALE);
+  TOUCH_CHECK_EQUAL(features[FEATURE_PATH], CLASSIFIER_POSITION_SCALE);
+  TOUCH_CHECK_EQUAL(features[FEATURE_REVERSALS], 0);
+  TOUCH_CHECK_EQUAL(features[FEATURE_PEAK_DELTA], 200);          // Twice the threshold
+  TOUCH_CHECK_EQUAL(features[FEATURE_MEAN_WIDTH], 16);           // One segment (Q4)
+  TOUCH_CHECK_EQUAL(decoder.getAmbiguousScans(), 0);
+}
+
+int main() {
+  slider.disablePrintSliderTouched();
+  slider.disablePrintSwipeStatus();
+  slider.disableTouchButtons();
+
+  testCrosstalkDisabled();
+  testSwipeSegments();
+  return TOUCH_TEST_RESULT();
+}
@@ -0,0 +1,188 @@
+#include "TouchSlider.h"
+#include "TouchTest.h"
+
+// Swipes, swipe fines and touched pads of the slider engine, driven through beginSimulation()/simulateScan().
+
+#define NUM_PADS          5
+#define BASELINE          1000
+#define TOUCH_DELTA       400             // Change of a touched pad, the threshold is 20% (200 counts)
+
+static TouchSlider slider(touchTestPins, 80, NUM_PADS);
+
+/**
+ * @brief Run one scan with a range of touched pads.
+ * @param first First touched pad, -1 for no touch.
+ * @param last Last touched pad.
+ */
+static void scanPads(int8_t first, int8_t last) {
+  uint32_t values[NUM_PADS];
+  for (int8_t i = 0; i < NUM_PADS; ++i) {
+    values[i] = i >= first && i <= last ? touchTestValue(BASELINE, TOUCH_DELTA) : BASELINE;
+  }
+  slider.simulateScan(values);
+}
+
+/**
+ * @brief Start a simulation with untouched pads and no pending events.
+ */
+static void startSimulation() {
+  uint32_t baseline[NUM_PADS];
+  for (uint8_t i = 0; i < NUM_PADS; ++i) {
+    baseline[i] = BASELINE;
+  }
+  slider.beginSimulation(baseline);
+  scanPads(-1, -1);
+  slider.getSwipeStatus();
+  slider.getSwipeStatusFine();
+}
+
+static void testIdle() {
+  startSimulation();
+  for (uint8_t i = 0; i < 5; ++i) {
+    scanPads(-1, -1);
+  }
+  TOUCH_CHECK_EQUAL(slider.getSwipeStatus(), 0);
+  TOUCH_CHECK_EQUAL(slider.getSwipeStatusFine(), 0);
+  for (uint8_t i = 0; i < NUM_PADS; ++i) {
+    TOUCH_CHECK(!slider.isTouchSliderPressed(touchTestPins[i]));
+  }
+}
+
+static void testSwipeUp() {
+  startSimulation();
+  for (int8_t pad = 0; pad < NUM_PADS; ++pad) {   // Towards the last pad, two steps per pad
+    scanPads(pad, pad);
+  }
+  scanPads(NUM_PADS - 1, NUM_PADS - 1);
+  scanPads(-1, -1);
+  TOUCH_CHECK_EQUAL(slider.getSwipeStatus(), -2 * (NUM_PADS - 1));
+  TOUCH_CHECK_EQUAL(slider.getSwipeStatusFine(), 0);
+}
+
+static void testSwipeDown() {
+  startSimulation();
+  for (int8_t pad = NUM_PADS - 1; pad >= 0; --pad) {
+    scanPads(pad, pad);
+  }
+  scanPads(0, 0);
+  scanPads(-1, -1);
+  TOUCH_CHECK_EQUAL(slider.getSwipeStatus(), 2 * (NUM_PADS - 1));
+}
+
+static void testHalfSteps() {
+  startSimulation();
+  scanPads(0, 0);
+  scanPads(0, 1);     // Between two pads
+  TOUCH_CHECK_EQUAL(slider.getSwipeStatus(), -1);
+  scanPads(1, 1);
+  TOUCH_CHECK_EQUAL(slider.getSwipeStatus(), -1);
+  scanPads(1, 1);
+  scanPads(-1, -1);
+  TOUCH_CHECK_EQUAL(slider.getSwipeStatus(), 0);
+}
+
+static void testReversalHysteresis() {
+  startSimulation();
+  scanPads(0, 0);
+  scanPads(1, 1);     // Swipe up one pad
+  scanPads(1, 2);     // Between pads 1 and 2, the noise moves the touch back and forth
+  scanPads(1, 1);
+  scanPads(1, 2);
+  scanPads(1, 1);
+  TOUCH_CHECK_EQUAL(slider.getSwipeStatus(), -3);    // The half pad steps back are held
+
+  scanPads(0, 1);     // A full pad back is a reversal
+  TOUCH_CHECK_EQUAL(slider.getSwipeStatus(), 2);
+  scanPads(0, 1);
+  scanPads(-1, -1);
+  slider.getSwipeStatusFine();
+}
+
+static void testExtrapolationSlow() {
+  startSimulation();
+  scanPads(0, 0);     // Hold the first pad
+  scanPads(0, 0);
+  scanPads(0, 0);
+  scanPads(1, 1);     // One pad per scan, not extrapolated
+  scanPads(-1, -1);
+  TOUCH_CHECK_EQUAL(slider.getSwipeStatus(), -2);
+}
+
+static void testExtrapolationFast() {
+  startSimulation();
+  uint32_t swipeEvents = slider.getMetrics().getCounter(METRIC_SWIPE_UP);
+  scanPads(0, 0);
+  scanPads(2, 2);     // Pad 1 skipped: 4 steps in one scan, 2 more in the half scan before lifting
+  scanPads(-1, -1);
+  TOUCH_CHECK_EQUAL(slider.getSwipeStatus(), -6);
+  TOUCH_CHECK_EQUAL(slider.getMetrics().getCounter(METRIC_SWIPE_UP), swipeEvents + 1);   // One event, the extrapolated steps are part of it
+
+  scanPads(2, 2);
+  scanPads(NUM_PADS - 1, NUM_PADS - 1);   // Pad 3 skipped, but the finger reached the edge
+  scanPads(-1, -1);
+  TOUCH_CHECK_EQUAL(slider.getSwipeStatus(), -4);
+}
+
+static void testTwoFingerHold() {
+  startSimulation();
+  uint32_t shortTouches = slider.getMetrics().getCounter(METRIC_SHORT_TOUCHES);
+  uint32_t values[NUM_PADS];
+  for (uint8_t i = 0; i < NUM_PADS; ++i) {
+    values[i] = i == 0 || i == NUM_PADS - 1 ? touchTestValue(BASELINE, TOUCH_DELTA) : BASELINE;
+  }
+  for (uint8_t scan = 0; scan < 5; ++scan) {    // Two fingers held on the edge pads
+    slider.simulateScan(values);
+  }
+  scanPads(-1, -1);
+  TOUCH_CHECK_EQUAL(slider.getMetrics().getCounter(METRIC_SHORT_TOUCHES), shortTouches);
+
+  scanPads(2, 2);     // A single scan is still a short touch
+  scanPads(-1, -1);
+  TOUCH_CHECK_EQUAL(slider.getMetrics().getCounter(METRIC_SHORT_TOUCHES), shortTouches + 1);
+  slider.getSwipeStatus();
+  slider.getSwipeStatusFine();
+}
+
+static void testSwipeFine() {
+  startSimulation();
+  scanPads(0, 0);     // Tap on the first pad
+  scanPads(-1, -1);
+  TOUCH_CHECK_EQUAL(slider.getSwipeStatusFine(), 1);
+
+  scanPads(NUM_PADS - 1, NUM_PADS - 1);   // Tap on the last pad
+  scanPads(-1, -1);
+  TOUCH_CHECK_EQUAL(slider.getSwipeStatusFine(), -1);
+  TOUCH_CHECK_EQUAL(slider.getSwipeStatus(), 0);
+}
+
+static void testTouchedPads() {
+  startSimulation();
+  scanPads(2, 3);
+  bool touched[NUM_PADS];
+  slider.getSliderTouched(touched, NUM_PADS);
+  for (uint8_t i = 0; i < NUM_PADS; ++i) {
+    TOUCH_CHECK_EQUAL(touched[i], i == 2 || i == 3);
+  }
+  TOUCH_CHECK(slider.isTouchSliderPressed(touchTestPins[2]));
+  TOUCH_CHECK(!slider.isTouchSliderPressed(touchTestPins[0]));
+  scanPads(-1, -1);
+}
+
+int main() {
+  slider.disablePrintSliderTouched();
+  slider.disablePrintSwipeStatus();
+  slider.disableTouchButtons();
+  slider.enableSwipeFine();
+
+  testIdle();
+  testSwipeUp();
+  testSwipeDown();
+  testHalfSteps();
+  testReversalHysteresis();
+  testExtrapolationSlow();
+  testExtrapolationFast();
+  testTwoFingerHold();
+  testSwipeFine();
+  testTouchedPads();
+  return TOUCH_TEST_RESULT();
+}
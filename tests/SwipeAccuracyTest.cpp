@@ -0,0 +1,156 @@
+#include "TouchSlider.h"
+#include "TouchFingerModel.h"
+#include "TouchTest.h"
+
+// Swipe accuracy vs. scan rate. A synthetic finger swipes across the slider at several speeds, both directions and
+// several landing phases, and its values are injected in the real slider engine for every scan interval and number of
+// pads. Each setting prints a CSV row:
+//   missed   swipes without any swipe event in the right direction
+//   wrong    swipe events in the wrong direction
+//   latency  mean time from the landing of the finger to the first swipe event, in ms
+//   steps    mean swipe steps reported per swipe, a full swipe is 2 * (pads - 1) steps (two per pad)
+// and the test fails when a setting misses a swipe the scans can see, detects a swipe late, reports more steps than
+// the slider has or any step in the wrong direction.
+
+#define THRESHOLD_SLIDER  80              // Threshold slider on percentage, touched when the value changes 20%
+#define BASELINE          1000            // Untouched value of the synthetic pads
+#define TOUCH_DELTA       400             // Change of a pad fully covered by the finger
+#define FINGER_WIDTH      1200            // Contact width in milli-pads, narrower fingers release the slider between pads
+#define FINGER_PRESSURE   90              // Coupling of the finger in percentage
+#define FINGER_NOISE      20              // Peak noise in counts
+#define PHASES            8               // Landing phases per scan interval
+#define IDLE_SCANS        3               // Untouched scans before and after each swipe
+#define MAX_PADS          8
+
+static const uint8_t padCounts[] = {3, 4, 6, 8};                    // Pads of the slider
+static const uint16_t scanIntervals[] = {10, 20, 30, 50, 100};      // Scan intervals in ms
+static const uint16_t speeds[] = {5, 10, 20, 40, 80, 160};          // Swipe speeds in pads per second
+
+struct SwipeResult {
+  uint16_t swipes;          // Swipes simulated
+  uint16_t missed;          // Swipes without a swipe event in the right direction
+  uint16_t wrong;           // Swipe events in the wrong direction
+  uint32_t latencySumMs;    // Sum of the detection latency of the detected swipes
+  uint32_t latencyMaxMs;    // Longest detection latency
+  uint32_t steps;           // Swipe steps in the right direction
+  int16_t maxSteps;         // Most steps reported by one swipe, right minus wrong
+};
+
+/**
+ * @brief Simulate one swipe of the finger through the slider engine.
+ */
+static void simulateSwipe(TouchSlider &slider, TouchFingerModel &finger, uint8_t numPads, uint16_t intervalMs,
+                          uint32_t landMs, bool increasing, SwipeResult &result) {
+  uint32_t values[MAX_PADS];
+  uint32_t baseline[MAX_PADS];
+  for (uint8_t i = 0; i < numPads; ++i) {
+    baseline[i] = BASELINE;
+  }
+
+  slider.beginSimulation(baseline);
+  for (uint8_t i = 0; i < IDLE_SCANS; ++i) {    // Leave the engine untouched and clear the pending events
+    slider.simulateScan(baseline);
+  }
+  slider.getSwipeStatus();
+  slider.getSwipeStatusFine();
+
+  finger.startSwipe(landMs, increasing);
+  bool detected = false;
+  uint16_t swipeSteps = 0;
+  uint16_t wrongSteps = 0;
+  uint32_t endMs = finger.getLiftMs() + IDLE_SCANS * intervalMs;
+  for (uint32_t timeMs = 0; timeMs <= endMs; timeMs += intervalMs) {
+    for (uint8_t i = 0; i < numPads; ++i) {
+      values[i] = finger.read(i, timeMs);
+    }
+    slider.simulateScan(values);
+
+    int8_t status = slider.getSwipeStatus();      // Positive: swipe down (towards the first pad), negative: swipe up (towards the last pad)
+    int8_t steps = increasing ? -status : status;
+    if (steps > 0) {
+      swipeSteps += steps;
+      if (!detected) {
+        uint32_t latencyMs = timeMs - landMs;
+        result.latencySumMs += latencyMs;
+        if (latencyMs > result.latencyMaxMs) result.latencyMaxMs = latencyMs;
+      }
+      detected = true;
+    } else if (steps < 0) {
+      wrongSteps += -steps;
+    }
+  }
+  slider.getSwipeStatusFine();
+
+  result.swipes++;
+  result.steps += swipeSteps;
+  result.wrong += wrongSteps;
+  int16_t netSteps = static_cast<int16_t>(swipeSteps) - wrongSteps;
+  if (netSteps > result.maxSteps) result.maxSteps = netSteps;
+  if (!detected) result.missed++;
+}
+
+/**
+ * @brief Check the result of a setting.
+ *
+ * A swipe is visible when the finger stays on the slider for three scan intervals, so at least three scans see it.
+ * A visible swipe must not be missed. The first touched scan comes up to one interval after the landing, the touched
+ * pads of the finger change within one pad of motion (between half a pad and a pad for a finger wider than a pad), and
+ * the next scan sees the change, so the latency is at most one pad of motion plus two intervals. No step may go in the
+ * wrong direction and no swipe may report more steps than the slider has.
+ */
+static void checkResult(uint8_t numPads, uint16_t intervalMs, uint16_t speed, const SwipeResult &result) {
+  uint32_t durationMs = static_cast<uint32_t>(numPads - 1) * 1000 / speed;
+  uint32_t latencyLimitMs = 1000 / speed + 2 * intervalMs;
+  bool visible = durationMs >= 3 * intervalMs;
+  bool failed = result.wrong != 0 || result.maxSteps > 2 * (numPads - 1) ||
+                (visible && (result.missed != 0 || result.latencyMaxMs > latencyLimitMs));
+  TOUCH_CHECK_EQUAL(result.wrong, 0);
+  TOUCH_CHECK(result.maxSteps <= 2 * (numPads - 1));
+  if (visible) {
+    TOUCH_CHECK_EQUAL(result.missed, 0);
+    TOUCH_CHECK(result.latencyMaxMs <= latencyLimitMs);
+  }
+  if (failed)
+    printf("FAIL pads %u, interval %u ms, speed %u pads/s\n", numPads, intervalMs, speed);
+}
+
+int main() {
+  printf("pads,interval_ms,speed_pads_s,swipes,missed,wrong,latency_ms,latency_max_ms,steps,steps_max\n");
+
+  for (uint8_t p = 0; p < sizeof(padCounts) / sizeof(padCounts[0]); ++p) {
+    uint8_t numPads = padCounts[p];
+    TouchSlider slider(touchTestPins, THRESHOLD_SLIDER, numPads);
+    slider.disablePrintSliderTouched();     // Keep the output clean
+    slider.disablePrintSwipeStatus();
+    slider.disableTouchButtons();
+
+    TouchFingerModel finger(numPads, BASELINE, TOUCH_DELTA, TouchDriver::tracksBaseline());   // The value rises on touch when the hardware tracks the baseline (v2)
+    finger.setWidth(FINGER_WIDTH);
+    finger.setPressure(FINGER_PRESSURE);
+    finger.setNoise(FINGER_NOISE);
+
+    for (uint8_t s = 0; s < sizeof(scanIntervals) / sizeof(scanIntervals[0]); ++s) {
+      uint16_t intervalMs = scanIntervals[s];
+      slider.setUpdateInterval(intervalMs);
+
+      for (uint8_t v = 0; v < sizeof(speeds) / sizeof(speeds[0]); ++v) {
+        SwipeResult result = {};
+        finger.setSpeed(speeds[v]);
+        for (uint8_t phase = 0; phase < PHASES; ++phase) {   // Land between two scans at several points
+          uint32_t landMs = intervalMs + static_cast<uint32_t>(intervalMs) * phase / PHASES;
+          simulateSwipe(slider, finger, numPads, intervalMs, landMs, true, result);
+          simulateSwipe(slider, finger, numPads, intervalMs, landMs, false, result);
+        }
+
+        uint16_t detected = result.swipes - result.missed;
+        printf("%u,%u,%u,%u,%u,%u,%u,%u,%u.%02u,%d\n", numPads, intervalMs, speeds[v], result.swipes, result.missed,
+               result.wrong, detected > 0 ? static_cast<unsigned>(result.latencySumMs / detected) : 0,
+               static_cast<unsigned>(result.latencyMaxMs), static_cast<unsigned>(result.steps / result.swipes),
+               static_cast<unsigned>(result.steps % result.swipes * 100 / result.swipes), result.maxSteps);
+        checkResult(numPads, intervalMs, speeds[v], result);
+      }
+    }
+    slider.endSimulation();
+  }
+  return TOUCH_TEST_RESULT();
+}
@@ -0,0 +1,101 @@
+#include "TouchFingerModel.h"
+
+/*********************** CONSTRUCTORS **********************/
+/**
+ * @brief Constructor for TouchFingerModel class
+ *
+ * @param numPads Pads of the slider.
+ * @param baseline Untouched value of every pad.
+ * @param touchDelta Change of the value when the finger fully covers a pad with full pressure.
+ * @param risesOnTouch true for the ESP32-S2/S3 touch sensor (value rises on touch), false for the ESP32 (value drops).
+ **/
+TouchFingerModel::TouchFingerModel(uint8_t numPads, uint32_t baseline, uint32_t touchDelta, bool risesOnTouch) {
+  _numPads = numPads > 0 ? numPads : 1;
+  _baseline = baseline;
+  _touchDelta = touchDelta;
+  _risesOnTouch = risesOnTouch;
+  if (!_risesOnTouch && _touchDelta > _baseline)
+    _touchDelta = _baseline;
+}
+
+/*********************** PUBLIC FUNCTIONS **********************/
+/**
+ * @brief Land the finger on the first pad of a swipe.
+ * @param landMs Time the finger lands.
+ * @param increasing true to swipe from pad 0 to the last pad, false for the opposite direction.
+ */
+void TouchFingerModel::startSwipe(uint32_t landMs, bool increasing) {
+  _landMs = landMs;
+  _increasing = increasing;
+}
+
+/**
+ * @brief Get the time the finger is on the slider, from the center of the first pad to the center of the last one.
+ * @return The duration of the swipe in ms.
+ */
+uint32_t TouchFingerModel::getDurationMs() {
+  return static_cast<uint32_t>(_numPads - 1) * 1000 / _speed;
+}
+
+/**
+ * @brief Get the center of the finger.
+ * @param timeMs The time.
+ * @return The center in milli-pads, clamped to the centers of the first and last pads.
+ */
+int32_t TouchFingerModel::getPosition(uint32_t timeMs) {
+  int32_t first = FINGER_PAD_PITCH / 2;
+  int32_t last = static_cast<int32_t>(_numPads - 1) * FINGER_PAD_PITCH + FINGER_PAD_PITCH / 2;
+  int32_t travelled = timeMs <= _landMs ? 0 : static_cast<int32_t>(timeMs - _landMs) * _speed;   // pads/s = milli-pads/ms
+  if (travelled > last - first)
+    travelled = last - first;
+  return _increasing ? first + travelled : last - travelled;
+}
+
+/**
+ * @brief Get the value of a pad.
+ *
+ * The change from the baseline is proportional to the part of the pad covered by the finger, a finger narrower than a
+ * pad fully on it gives the full change.
+ *
+ * @param pad The pad (0 to numPads - 1).
+ * @param timeMs The time.
+ * @return The value of the pad, with noise.
+ */
+uint32_t TouchFingerModel::read(uint8_t pad, uint32_t timeMs) {
+  int64_t change = 0;
+  if (isTouching(timeMs) && pad < _numPads) {
+    int32_t center = getPosition(timeMs);
+    int32_t fingerStart = center - _width / 2;
+    int32_t fingerEnd = center + _width / 2;
+    int32_t padStart = static_cast<int32_t>(pad) * FINGER_PAD_PITCH;
+    int32_t padEnd = padStart + FINGER_PAD_PITCH;
+
+    int32_t overlap = (fingerEnd < padEnd ? fingerEnd : padEnd) - (fingerStart > padStart ? fingerStart : padStart);
+    int32_t fullOverlap = _width < FINGER_PAD_PITCH ? _width : FINGER_PAD_PITCH;
+    if (overlap > 0)
+      change = static_cast<int64_t>(_touchDelta) * _pressure / 100 * overlap / fullOverlap;
+  }
+
+  int64_t value = _risesOnTouch ? static_cast<int64_t>(_baseline) + change : static_cast<int64_t>(_baseline) - change;
+  value += noise();
+  return value < 0 ? 0 : static_cast<uint32_t>(value);
+}
+
+/*********************** PRIVATE FUNCTIONS **********************/
+/**
+ * @brief Get a noise sample, the sum of two uniform samples (xorshift32) gives a triangular distribution.
+ * @return The noise in counts, between -_noise and _noise.
+ */
+int32_t TouchFingerModel::noise() {
+  if (_noise == 0)
+    return 0;
+
+  int32_t sum = 0;
+  for (uint8_t i = 0; i < 2; ++i) {
+    _seed ^= _seed << 13;
+    _seed ^= _seed >> 17;
+    _seed ^= _seed << 5;
+    sum += static_cast<int32_t>(_seed % (2U * _noise + 1)) - _noise;
+  }
+  return sum / 2;
+}
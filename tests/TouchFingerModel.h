@@ -0,0 +1,69 @@
+/*
+* Marcos Abraham Carballo Vazquez
+* Original Creation Date: Dicember 5, 2024
+* https://github.com/MarcosCarballoV/TouchSlider_ESP32
+* */
+
+#ifndef TOUCHFINGERMODEL_H
+#define TOUCHFINGERMODEL_H
+
+/**
+* Synthetic finger for offline benchmarks of the slider engine.
+*
+* The finger lands on the center of the first pad of the swipe, moves at a constant speed and lifts on the center of
+* the last pad. The value of each pad follows the overlap between the finger and the pad: a finger fully on a pad
+* changes it by touchDelta * pressure / 100, in the touch direction of the backend, plus noise.
+* Positions are in milli-pads (1000 = one pad pitch, 0 is the start of pad 0) and times in ms.
+*
+* Feed the values to TouchSlider::simulateScan() to run the real engine without touching the pads.
+*/
+/*********************** EXTERNAL LIBRARIES **********************/
+
+#include <stdint.h>
+
+/*********************** LIBRARY OPTIONS **********************/
+#define FINGER_PAD_PITCH          1000        // Milli-pads per pad
+
+/*********************** CLASS DEFINITION **********************/
+
+class TouchFingerModel
+{
+  public:
+    // Constructor
+    TouchFingerModel(uint8_t numPads, uint32_t baseline, uint32_t touchDelta, bool risesOnTouch);    // Constructor with the untouched value and the change of a full touch
+
+    // Finger parameters
+    void setSpeed(uint16_t padsPerSecond) {_speed = padsPerSecond > 0 ? padsPerSecond : 1;};   // Set the swipe speed in pads per second
+    void setWidth(uint16_t width) {_width = width > 0 ? width : 1;};               // Set the contact width in milli-pads
+    void setPressure(uint8_t pressure) {_pressure = pressure > 100 ? 100 : pressure;};   // Set the coupling of the finger (0-100%)
+    void setNoise(uint16_t noise) {_noise = noise;};                               // Set the peak noise in counts
+    void setSeed(uint32_t seed) {_seed = seed != 0 ? seed : 1;};                   // Set the seed of the noise
+
+    // Swipe
+    void startSwipe(uint32_t landMs, bool increasing);                             // Land the finger at landMs, swiping to the higher (increasing) or lower pads
+    uint32_t getLiftMs() {return _landMs + getDurationMs();};                      // Get the time the finger lifts
+    uint32_t getDurationMs();                                                      // Get the time the finger is on the slider
+    bool isTouching(uint32_t timeMs) {return timeMs >= _landMs && timeMs < getLiftMs();};   // Check if the finger is on the slider
+    int32_t getPosition(uint32_t timeMs);                                          // Get the center of the finger in milli-pads
+
+    // Readings
+    uint32_t read(uint8_t pad, uint32_t timeMs);                                   // Get the value of a pad at a time
+
+  private:
+    uint8_t _numPads;                                                 // Pads of the slider
+    uint32_t _baseline;                                               // Untouched value
+    uint32_t _touchDelta;                                             // Change of a full touch
+    bool _risesOnTouch;                                               // The value rises on touch (ESP32-S2/S3) or drops (ESP32)
+
+    uint16_t _speed = 100;                                            // Swipe speed in pads per second
+    uint16_t _width = 800;                                            // Contact width in milli-pads
+    uint8_t _pressure = 100;                                          // Coupling of the finger (0-100%)
+    uint16_t _noise = 0;                                              // Peak noise in counts
+    uint32_t _seed = 1;                                               // State of the noise generator
+
+    uint32_t _landMs = 0;                                             // Time the finger lands
+    bool _increasing = true;                                          // Swipe direction
+
+    int32_t noise();                                                  // Triangular noise between -_noise and _noise
+};
+#endif
@@ -0,0 +1,63 @@
+/*
+* Marcos Abraham Carballo Vazquez
+* Original Creation Date: Dicember 5, 2024
+* https://github.com/MarcosCarballoV/TouchSlider_ESP32
+* */
+
+#ifndef TOUCHTEST_H
+#define TOUCHTEST_H
+
+/**
+* Checks of the host tests. A failed check prints its location and the test keeps running, so one run reports every
+* failure. main() returns TOUCH_TEST_RESULT() to ctest.
+*
+* The slider pins and the readings of a touched pad follow the backend the test is built for (v1: the value drops on
+* touch, v2: it rises).
+*/
+/*********************** EXTERNAL LIBRARIES **********************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include "TouchDriver.h"
+
+/*********************** PADS **********************/
+#if defined(TOUCHSLIDER_TOUCH_V2)
+static const gpio_num_t touchTestPins[] = {GPIO_NUM_1, GPIO_NUM_2, GPIO_NUM_3, GPIO_NUM_4, GPIO_NUM_5, GPIO_NUM_6, GPIO_NUM_7, GPIO_NUM_8};
+static const gpio_num_t TOUCH_TEST_FREE_PIN = GPIO_NUM_9;            // Touch pin that is not a slider pin
+#else
+static const gpio_num_t touchTestPins[] = {GPIO_NUM_33, GPIO_NUM_27, GPIO_NUM_14, GPIO_NUM_4, GPIO_NUM_13, GPIO_NUM_12, GPIO_NUM_2, GPIO_NUM_0};
+static const gpio_num_t TOUCH_TEST_FREE_PIN = GPIO_NUM_15;           // Touch pin that is not a slider pin
+#endif
+
+/**
+ * @brief Get the reading of a pad moved some counts in the touch direction of the backend.
+ * @param baseline Untouched value of the pad.
+ * @param delta Change towards touch, negative values move away from touch.
+ * @return The reading.
+ */
+static inline uint32_t touchTestValue(uint32_t baseline, int32_t delta) {
+  return TouchDriver::tracksBaseline() ? baseline + delta : baseline - delta;
+}
+
+/*********************** CHECKS **********************/
+static int touchTestFailures = 0;                                     // Failed checks of the test program
+
+#define TOUCH_CHECK(condition) do { \
+    if (!(condition)) { \
+      printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition); \
+      touchTestFailures++; \
+    } \
+  } while (0)
+
+#define TOUCH_CHECK_EQUAL(actual, expected) do { \
+    long long touchActual = static_cast<long long>(actual); \
+    long long touchExpected = static_cast<long long>(expected); \
+    if (touchActual != touchExpected) { \
+      printf("FAIL %s:%d: %s is %lld, expected %lld\n", __FILE__, __LINE__, #actual, touchActual, touchExpected); \
+      touchTestFailures++; \
+    } \
+  } while (0)
+
+#define TOUCH_TEST_RESULT()     (touchTestFailures == 0 ? 0 : 1)
+
+#endif
@@ -0,0 +1,88 @@
+#include "TouchTuneModel.h"
+
+/*********************** CONSTRUCTORS **********************/
+/**
+ * @brief Constructor for TouchTuneModel class
+ *
+ * @param numPads Pads of the model, limited to TUNE_MAX_PADS.
+ * @param baseline Untouched value of every pad.
+ * @param noise Noise of every pad at the reference cycles and 100% voltage noise, in counts.
+ * @param referenceCycles Measurement cycles of that noise.
+ **/
+TouchTuneModel::TouchTuneModel(uint8_t numPads, uint32_t baseline, uint16_t noise, uint16_t referenceCycles) {
+  _numPads = numPads < TUNE_MAX_PADS ? numPads : TUNE_MAX_PADS;
+  _baseline = baseline;
+  _referenceCycles = referenceCycles > 0 ? referenceCycles : 1;
+  for (uint8_t i = 0; i < TUNE_MAX_PADS; ++i) {
+    _padNoise[i] = noise;
+    _noise[i] = noise;
+    _above[i] = true;
+  }
+  for (uint8_t i = 0; i < TUNE_MAX_VOLTAGES; ++i) {
+    _voltageNoise[i] = 100;
+  }
+}
+
+/*********************** PUBLIC FUNCTIONS **********************/
+/**
+ * @brief Set the noise of a pad.
+ * @param pad The pad (0 to numPads - 1).
+ * @param noise Noise at the reference cycles and 100% voltage noise, in counts.
+ */
+void TouchTuneModel::setPadNoise(uint8_t pad, uint16_t noise) {
+  if (pad < TUNE_MAX_PADS)
+    _padNoise[pad] = noise;
+}
+
+/**
+ * @brief Set the noise of a voltage range.
+ * @param voltage Index of the voltage range, below TUNE_MAX_VOLTAGES.
+ * @param percent Noise of the range, 100% is the noise set for the pads.
+ */
+void TouchTuneModel::setVoltageNoise(uint8_t voltage, uint8_t percent) {
+  if (voltage < TUNE_MAX_VOLTAGES)
+    _voltageNoise[voltage] = percent;
+}
+
+/**
+ * @brief Get the noise of a pad with a setting.
+ * @param pad The pad (0 to numPads - 1).
+ * @param setting The setting.
+ * @return The standard deviation of the readings, in counts.
+ */
+uint32_t TouchTuneModel::getNoise(uint8_t pad, const TouchTuneSetting &setting) {
+  if (pad >= TUNE_MAX_PADS)
+    return 0;
+
+  uint16_t cycles = setting.measCycles > 0 ? setting.measCycles : 1;
+  uint32_t scale = TouchAutoTuner::isqrt((static_cast<uint64_t>(_referenceCycles) << 16) / cycles);   // sqrt(referenceCycles / cycles), Q8
+  uint8_t percent = setting.voltage < TUNE_MAX_VOLTAGES ? _voltageNoise[setting.voltage] : 100;
+  return static_cast<uint64_t>(_padNoise[pad]) * scale * percent / (100 << 8);
+}
+
+/**
+ * @brief Apply a setting, the next reading of every pad is above its baseline.
+ * @param setting The setting.
+ */
+void TouchTuneModel::apply(const TouchTuneSetting &setting) {
+  for (uint8_t i = 0; i < _numPads; ++i) {
+    _noise[i] = getNoise(i, setting);
+    _above[i] = true;
+  }
+}
+
+/**
+ * @brief Take a reading of a pad, alternating above and below its baseline.
+ * @param pad The pad (0 to numPads - 1).
+ * @return The reading.
+ */
+uint32_t TouchTuneModel::read(uint8_t pad) {
+  if (pad >= _numPads)
+    return _baseline;
+
+  bool above = _above[pad];
+  _above[pad] = !above;
+  if (above)
+    return _baseline + _noise[pad];
+  return _noise[pad] < _baseline ? _baseline - _noise[pad] : 0;
+}
@@ -0,0 +1,55 @@
+/*
+* Marcos Abraham Carballo Vazquez
+* Original Creation Date: Dicember 5, 2024
+* https://github.com/MarcosCarballoV/TouchSlider_ESP32
+* */
+
+#ifndef TOUCHTUNEMODEL_H
+#define TOUCHTUNEMODEL_H
+
+/**
+* Synthetic electrodes for offline checks of TouchAutoTuner.
+*
+* Every pad reads its baseline plus a noise that falls with the square root of the measurement cycles, like the average
+* of more charge/discharge cycles, and scales with the voltage range:
+*   noise = padNoise * sqrt(referenceCycles / measCycles) * voltageNoise / 100
+* The readings alternate between baseline + noise and baseline - noise, so an even number of readings has exactly that
+* standard deviation and the SNR of every setting is known in advance.
+*/
+/*********************** EXTERNAL LIBRARIES **********************/
+
+#include <stdint.h>
+#include "TouchAutoTuner.h"
+
+/*********************** CLASS DEFINITION **********************/
+
+class TouchTuneModel : public TouchTuneSensor
+{
+  public:
+    // Constructor
+    TouchTuneModel(uint8_t numPads, uint32_t baseline, uint16_t noise, uint16_t referenceCycles);   // Constructor with the noise of every pad at the reference cycles
+
+    // Model parameters
+    void setPadNoise(uint8_t pad, uint16_t noise);                                   // Set the noise of a pad at the reference cycles, in counts
+    void setVoltageNoise(uint8_t voltage, uint8_t percent);                          // Set the noise of a voltage range, 100% is the noise of the pads
+    void setThresholdPercent(uint8_t thresholdPercent) {_thresholdPercent = thresholdPercent;};   // Set the threshold percentage of every pad
+    uint32_t getNoise(uint8_t pad, const TouchTuneSetting &setting);                 // Get the noise of a pad with a setting, in counts
+
+    // TouchTuneSensor
+    void apply(const TouchTuneSetting &setting) override;                            // Apply a setting
+    uint32_t read(uint8_t pad) override;                                             // Take a reading of a pad
+    uint8_t getNumPads() override {return _numPads;};                                // Get the number of pads
+    uint8_t getThresholdPercent(uint8_t pad) override {(void)pad; return _thresholdPercent;};   // Get the threshold percentage of a pad
+
+  private:
+    uint8_t _numPads;                                                 // Pads of the model
+    uint32_t _baseline;                                               // Untouched value
+    uint16_t _referenceCycles;                                        // Measurement cycles of the pad noise
+    uint8_t _thresholdPercent = 80;                                   // Threshold percentage of every pad
+    uint16_t _padNoise[TUNE_MAX_PADS];                                // Noise of each pad at the reference cycles
+    uint8_t _voltageNoise[TUNE_MAX_VOLTAGES];                         // Noise of each voltage range (%)
+
+    uint32_t _noise[TUNE_MAX_PADS];                                   // Noise of each pad with the applied setting
+    bool _above[TUNE_MAX_PADS];                                       // Side of the next reading of each pad
+};
+#endif
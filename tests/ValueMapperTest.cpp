@@ -0,0 +1,80 @@
+#include "TouchSlider.h"
+#include "TouchValueMapper.h"
+#include "TouchTest.h"
+
+// Units of TouchValueMapper: the slider reports half pad steps, the curve, gains and detents are in whole pads.
+
+#define NUM_PADS          5
+#define BASELINE          1000
+#define TOUCH_DELTA       400
+
+static void testHalfPadSteps() {
+  TouchValueMapper mapper(0, 100, 50);
+  TOUCH_CHECK_EQUAL(mapper.move(2, 100), 51);     // One pad, one unit without a curve
+  TOUCH_CHECK_EQUAL(mapper.move(1, 100), 51);     // Half a pad is kept for the next step
+  TOUCH_CHECK_EQUAL(mapper.move(1, 100), 52);
+  TOUCH_CHECK_EQUAL(mapper.move(-4, 100), 50);
+}
+
+static void testCurveSpeed() {
+  const TouchValueMapper::BallisticPoint curve[] = {
+    {5,  VALUE_MAPPER_GAIN_ONE},
+    {40, 10 * VALUE_MAPPER_GAIN_ONE}
+  };
+  TouchValueMapper mapper(0, 1000, 500);
+  mapper.setCurve(curve, 2);
+
+  TOUCH_CHECK_EQUAL(mapper.move(2, 400), 501);    // 2.5 pads per second, below the first point
+  TOUCH_CHECK_EQUAL(mapper.move(2, 25), 511);     // 40 pads per second, not 80
+  TOUCH_CHECK_EQUAL(mapper.move(1, 12), 516);     // Half a pad at 41 pads per second moves half the gain
+  TOUCH_CHECK_EQUAL(mapper.move(-1, 20), 513);    // Half a pad at 25 pads per second, interpolated gain of 6.1 per pad
+}
+
+static void testDetentSpeed() {
+  const int32_t detents[] = {55};
+  TouchValueMapper mapper(0, 100, 50);
+  mapper.setDetents(detents, 1, 2, 20);
+
+  TOUCH_CHECK_EQUAL(mapper.move(20, 100), 60);    // 100 pads per second go through the detent
+  mapper.setValue(50);
+  TOUCH_CHECK_EQUAL(mapper.move(20, 1000), 55);   // 10 pads per second stops on the detent
+  TOUCH_CHECK_EQUAL(mapper.move(4, 1000), 55);    // Two units are held
+  TOUCH_CHECK_EQUAL(mapper.move(2, 1000), 56);
+}
+
+static void testSliderSwipe() {
+  TouchSlider slider(touchTestPins, 80, NUM_PADS);
+  TouchValueMapper mapper(0, 100, 50);
+  slider.disablePrintSliderTouched();
+  slider.disablePrintSwipeStatus();
+  slider.disableTouchButtons();
+  slider.attachValueMapper(&mapper);
+
+  uint32_t values[NUM_PADS];
+  for (uint8_t i = 0; i < NUM_PADS; ++i) {
+    values[i] = BASELINE;
+  }
+  slider.beginSimulation(values);
+  slider.simulateScan(values);
+  for (int8_t pad = NUM_PADS - 1; pad >= 0; --pad) {   // Swipe down over every pad
+    for (uint8_t i = 0; i < NUM_PADS; ++i) {
+      values[i] = i == pad ? touchTestValue(BASELINE, TOUCH_DELTA) : BASELINE;
+    }
+    slider.simulateScan(values);
+  }
+  for (uint8_t i = 0; i < NUM_PADS; ++i) {
+    values[i] = BASELINE;
+  }
+  slider.simulateScan(values);
+
+  TOUCH_CHECK_EQUAL(slider.getSwipeStatus(), 2 * (NUM_PADS - 1));
+  TOUCH_CHECK_EQUAL(mapper.getValue(), 50 + NUM_PADS - 1);     // One unit per pad
+}
+
+int main() {
+  testHalfPadSteps();
+  testCurveSpeed();
+  testDetentSpeed();
+  testSliderSwipe();
+  return TOUCH_TEST_RESULT();
+}